@@ -0,0 +1,99 @@
+// Unit Includes
+#include "benchmark.h"
+
+// Qx Includes
+#include <qx/core/qx-iostream.h>
+
+namespace Bench
+{
+
+//===============================================================================================================
+// Result
+//===============================================================================================================
+
+double Result::unitsPerSecond() const { return bestNs > 0 ? (units * 1e9) / bestNs : 0.0; }
+
+QJsonObject Result::toJson() const
+{
+    QJsonObject json{
+        {u"suite"_s, suite},
+        {u"name"_s, name},
+        {u"unit"_s, unit},
+        {u"units"_s, static_cast<qint64>(units)},
+        {u"iterations"_s, static_cast<qint64>(iterations)},
+        {u"best_ns"_s, bestNs},
+        {u"mean_ns"_s, meanNs},
+        {u"units_per_second"_s, unitsPerSecond()}
+    };
+
+    if(!extra.isEmpty())
+        json[u"extra"_s] = extra;
+
+    return json;
+}
+
+//===============================================================================================================
+// Context
+//===============================================================================================================
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+Context::Context(const QString& suite, const Options& options) :
+    mSuite(suite),
+    mOptions(options)
+{}
+
+//-Instance Functions--------------------------------------------------------------------------------------------
+//Private:
+void Context::record(const QString& name, const QString& unit, quint64 units, quint64 iterations, qint64 bestNs, qint64 totalNs)
+{
+    Result r{
+        .suite = mSuite,
+        .name = name,
+        .unit = unit,
+        .units = units,
+        .iterations = iterations,
+        .bestNs = bestNs,
+        .meanNs = static_cast<qint64>(totalNs / iterations)
+    };
+    mResults.append(r);
+
+    Qx::cout << u"  %1: %2 ms (best of %3), %4 M%5/s"_s.arg(name.leftJustified(48))
+                                                       .arg(bestNs / 1e6, 0, 'f', 3)
+                                                       .arg(iterations)
+                                                       .arg(r.unitsPerSecond() / 1e6, 0, 'f', 2)
+                                                       .arg(unit) << Qt::endl;
+}
+
+//Public:
+const Options& Context::options() const { return mOptions; }
+QList<Result> Context::results() const { return mResults; }
+QStringList Context::failures() const { return mFailures; }
+
+void Context::fail(const QString& reason)
+{
+    mFailures.append(reason);
+    Qx::cout << u"  FAILED: "_s << reason << Qt::endl;
+}
+
+void Context::annotate(const QString& key, const QJsonValue& value)
+{
+    // Attaches to the most recent result
+    Q_ASSERT(!mResults.isEmpty());
+    mResults.last().extra[key] = value;
+    Qx::cout << u"    %1: %2"_s.arg(key, value.toVariant().toString()) << Qt::endl;
+}
+
+//===============================================================================================================
+// Registrar
+//===============================================================================================================
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+Registrar::Registrar(const QString& name, const QString& desc, Suite suite) { registry()[name] = {suite, desc}; }
+
+//-Class Functions------------------------------------------------------------------------------------------------
+//Public:
+QMap<QString, Registrar::Entry>& Registrar::registry() { static QMap<QString, Entry> registry; return registry; }
+
+}
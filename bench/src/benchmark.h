@@ -0,0 +1,134 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+// Standard Library Includes
+#include <functional>
+
+// Qt Includes
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMap>
+
+using namespace Qt::StringLiterals;
+
+//-Macros-------------------------------------------------------------------------------------------------------------------
+#define BENCHMARK_SUITE(name, desc) \
+    static void name##Suite(Bench::Context& ctx); \
+    static Bench::Registrar _##name##Registrar(QStringLiteral(#name), QStringLiteral(desc), &name##Suite); \
+    static void name##Suite(Bench::Context& ctx)
+
+namespace Bench
+{
+
+struct Options
+{
+    int maxMegapixels; // Image size cap for suites that scale with image size
+    int threads; // Passed along to the codec where it supports it
+};
+
+struct Result
+{
+    QString suite;
+    QString name;
+    QString unit;
+    quint64 units;
+    quint64 iterations;
+    qint64 bestNs;
+    qint64 meanNs;
+    QJsonObject extra; // Suite specific figures, i.e. output sizes
+
+    double unitsPerSecond() const;
+    QJsonObject toJson() const;
+};
+
+class Context
+{
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    static constexpr qint64 MIN_DURATION_NS = 500'000'000;
+    static constexpr quint64 MAX_ITERATIONS = 50;
+
+//-Instance Variables------------------------------------------------------------------------------------------------------
+private:
+    QString mSuite;
+    Options mOptions;
+    QList<Result> mResults;
+    QStringList mFailures;
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    Context(const QString& suite, const Options& options);
+
+//-Instance Functions----------------------------------------------------------------------------------------------
+private:
+    void record(const QString& name, const QString& unit, quint64 units, quint64 iterations, qint64 bestNs, qint64 totalNs);
+
+public:
+    const Options& options() const;
+    QList<Result> results() const;
+    QStringList failures() const;
+
+    void fail(const QString& reason);
+    void annotate(const QString& key, const QJsonValue& value);
+
+    /* Runs body repeatedly (after setup each time, which is not timed) until either enough time has passed to
+     * get a stable reading or the iteration cap is hit, then records the result with the throughput expressed
+     * as 'units' of 'unit' processed per run.
+     */
+    template<typename S, typename F>
+    void measure(const QString& name, const QString& unit, quint64 units, S setup, F body)
+    {
+        QElapsedTimer timer;
+        qint64 total = 0;
+        qint64 best = std::numeric_limits<qint64>::max();
+        quint64 it = 0;
+
+        while(it == 0 || (total < MIN_DURATION_NS && it < MAX_ITERATIONS))
+        {
+            setup();
+            timer.start();
+            body();
+            qint64 elapsed = timer.nsecsElapsed();
+
+            total += elapsed;
+            best = std::min(best, elapsed);
+            ++it;
+        }
+
+        record(name, unit, units, it, best, total);
+    }
+
+    template<typename F>
+    void measure(const QString& name, const QString& unit, quint64 units, F body)
+    {
+        measure(name, unit, units, []{}, body);
+    }
+};
+
+class Registrar
+{
+//-Aliases----------------------------------------------------------------------------------------------------------
+public:
+    using Suite = std::function<void(Context&)>;
+
+    struct Entry
+    {
+        Suite suite;
+        QString description;
+    };
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    Registrar(const QString& name, const QString& desc, Suite suite);
+
+//-Class Functions----------------------------------------------------------------------------------------------
+public:
+    static QMap<QString, Entry>& registry();
+};
+
+}
+
+#endif // BENCHMARK_H
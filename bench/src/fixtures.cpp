@@ -0,0 +1,53 @@
+// Unit Includes
+#include "fixtures.h"
+
+// Qt Includes
+#include <QRandomGenerator>
+
+namespace Bench
+{
+
+QImage randomImage(const QSize& dim, QImage::Format format)
+{
+    QImage img(dim, QImage::Format_ARGB32);
+    QRandomGenerator gen(1);
+    for(int y = 0; y < img.height(); y++)
+    {
+        QRgb* line = reinterpret_cast<QRgb*>(img.scanLine(y));
+        gen.fillRange(line, img.width());
+    }
+
+    return format == QImage::Format_ARGB32 ? img : img.convertToFormat(format);
+}
+
+QByteArray randomData(qint64 size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    QRandomGenerator gen(2);
+    for(char& b : data)
+        b = static_cast<char>(gen.bounded(256));
+
+    return data;
+}
+
+QList<QSize> imageSizes(int maxMegapixels)
+{
+    static const QList<std::pair<int, QSize>> sizes{
+        {1, {1000, 1000}},
+        {4, {2000, 2000}},
+        {16, {4000, 4000}},
+        {50, {8660, 5774}},
+        {100, {10000, 10000}}
+    };
+
+    QList<QSize> selected;
+    for(const auto& [mp, dim] : sizes)
+        if(mp <= maxMegapixels)
+            selected.append(dim);
+
+    return selected;
+}
+
+QString sizeString(const QSize& dim) { return QStringLiteral("%1x%2").arg(dim.width()).arg(dim.height()); }
+
+}
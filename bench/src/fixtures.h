@@ -0,0 +1,23 @@
+#ifndef FIXTURES_H
+#define FIXTURES_H
+
+// Qt Includes
+#include <QByteArray>
+#include <QImage>
+#include <QList>
+#include <QSize>
+
+namespace Bench
+{
+
+// Deterministic inputs, so that results stay comparable between runs
+QImage randomImage(const QSize& dim, QImage::Format format = QImage::Format_ARGB32);
+QByteArray randomData(qint64 size);
+
+// Roughly square images from 1MP up to (and including) 'maxMegapixels', of the sizes 1, 4, 16, 50 and 100MP
+QList<QSize> imageSizes(int maxMegapixels);
+QString sizeString(const QSize& dim);
+
+}
+
+#endif // FIXTURES_H
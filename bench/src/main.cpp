@@ -0,0 +1,110 @@
+// Qt Includes
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSysInfo>
+
+// Qx Includes
+#include <qx/core/qx-iostream.h>
+
+// Project Includes
+#include "benchmark.h"
+
+namespace
+{
+
+bool writeReport(const QString& path, const Bench::Options& options, const QJsonArray& results, const QStringList& failures)
+{
+    QJsonObject report{
+        {u"timestamp"_s, QDateTime::currentDateTimeUtc().toString(Qt::ISODate)},
+        {u"qt_version"_s, QString::fromLatin1(qVersion())},
+        {u"cpu_architecture"_s, QSysInfo::currentCpuArchitecture()},
+        {u"os"_s, QSysInfo::prettyProductName()},
+        {u"options"_s, QJsonObject{
+            {u"max_megapixels"_s, options.maxMegapixels},
+            {u"threads"_s, options.threads}
+        }},
+        {u"results"_s, results},
+        {u"failures"_s, QJsonArray::fromStringList(failures)}
+    };
+
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    return file.write(QJsonDocument(report).toJson()) != -1;
+}
+
+}
+
+/* Usage: pxcrypt_bench [--json <file>] [--max-mp <n>] [--threads <n>] [suite...]
+ *
+ * Runs the named suites, or all of them if none are given, optionally writing every result to a JSON report
+ * so that runs from different releases can be compared. The exit code is non-zero if any suite reported
+ * a failure (i.e. a mismatch between an optimized path and its reference, or a broken round trip).
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const auto& registry = Bench::Registrar::registry();
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption jsonOption(u"json"_s, u"Write results to <file> as JSON."_s, u"file"_s);
+    QCommandLineOption maxMpOption(u"max-mp"_s, u"Largest image size, in megapixels, used by size scaled suites (default 16)."_s, u"n"_s, u"16"_s);
+    QCommandLineOption threadsOption(u"threads"_s, u"Thread count given to the encoders/decoders (default 1, 0 for ideal)."_s, u"n"_s, u"1"_s);
+    QCommandLineOption listOption(u"list"_s, u"List the available suites and exit."_s);
+    parser.addOptions({jsonOption, maxMpOption, threadsOption, listOption});
+    parser.addPositionalArgument(u"suite"_s, u"Suites to run (all if none)."_s, u"[suite...]"_s);
+    parser.process(app);
+
+    if(parser.isSet(listOption))
+    {
+        for(auto [name, entry] : registry.asKeyValueRange())
+            Qx::cout << name << u" - "_s << entry.description << Qt::endl;
+        return 0;
+    }
+
+    Bench::Options options{
+        .maxMegapixels = parser.value(maxMpOption).toInt(),
+        .threads = parser.value(threadsOption).toInt()
+    };
+
+    QStringList selected = parser.positionalArguments();
+    if(selected.isEmpty())
+        selected = registry.keys();
+
+    QJsonArray results;
+    QStringList failures;
+    for(const QString& name : std::as_const(selected))
+    {
+        if(!registry.contains(name))
+        {
+            Qx::cout << u"Unknown suite: "_s << name << Qt::endl;
+            return 1;
+        }
+
+        const auto& entry = registry[name];
+        Qx::cout << name << u" - "_s << entry.description << Qt::endl;
+
+        Bench::Context ctx(name, options);
+        entry.suite(ctx);
+
+        for(const Bench::Result& r : ctx.results())
+            results.append(r.toJson());
+        for(const QString& f : ctx.failures())
+            failures.append(name + u": "_s + f);
+    }
+
+    if(parser.isSet(jsonOption) && !writeReport(parser.value(jsonOption), options, results, failures))
+    {
+        Qx::cout << u"Failed to write report to "_s << parser.value(jsonOption) << Qt::endl;
+        return 1;
+    }
+
+    return failures.isEmpty() ? 0 : 1;
+}
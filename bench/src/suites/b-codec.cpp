@@ -0,0 +1,245 @@
+// Standard Library Includes
+#include <cmath>
+
+// Qt Includes
+#include <QImage>
+
+// Project Includes
+#include "benchmark.h"
+#include "fixtures.h"
+#include "codec/encdec.h"
+#include "pxcrypt/codec/standard_encoder.h"
+#include "pxcrypt/codec/standard_decoder.h"
+
+using namespace PxCryptPrivate;
+using Encoding = PxCrypt::Encoder::Encoding;
+using ReadOrder = PxCrypt::Decoder::ReadOrder;
+
+namespace
+{
+
+const QByteArray PSK = "Benchmark key"_ba;
+const QByteArray TAG = "benchmark.bin"_ba;
+
+struct Spread
+{
+    double altered; // Fraction of all pixels
+    double tileMin; // Least altered fraction of any tile
+    double tileMax; // Most altered fraction of any tile
+    double tileCv; // Coefficient of variation of the altered fraction across tiles
+};
+
+// How evenly the pixels altered by encoding are distributed across the image, in 64x64 tiles
+Spread alteredSpread(const QImage& medium, const QImage& encoded)
+{
+    const int TILE = 64;
+    const QImage before = medium.convertToFormat(QImage::Format_ARGB32);
+    const QImage after = encoded.convertToFormat(QImage::Format_ARGB32);
+    int cols = (before.width() + TILE - 1) / TILE;
+    int rows = (before.height() + TILE - 1) / TILE;
+
+    QList<quint64> altered(cols * rows, 0);
+    QList<quint64> counts(cols * rows, 0);
+    quint64 alteredTotal = 0;
+    for(int y = 0; y < before.height(); ++y)
+    {
+        const QRgb* b = reinterpret_cast<const QRgb*>(before.constScanLine(y));
+        const QRgb* a = reinterpret_cast<const QRgb*>(after.constScanLine(y));
+        for(int x = 0; x < before.width(); ++x)
+        {
+            qsizetype t = (y / TILE) * cols + (x / TILE);
+            counts[t]++;
+            if(b[x] != a[x])
+            {
+                altered[t]++;
+                alteredTotal++;
+            }
+        }
+    }
+
+    Spread spread{.altered = double(alteredTotal) / (quint64(before.width()) * before.height()), .tileMin = 1.0, .tileMax = 0.0, .tileCv = 0.0};
+    double sum = 0, sumSq = 0;
+    for(qsizetype t = 0; t < altered.size(); ++t)
+    {
+        double f = double(altered[t]) / counts[t];
+        spread.tileMin = std::min(spread.tileMin, f);
+        spread.tileMax = std::max(spread.tileMax, f);
+        sum += f;
+        sumSq += f * f;
+    }
+
+    double mean = sum / altered.size();
+    double variance = std::max(0.0, sumSq / altered.size() - mean * mean);
+    spread.tileCv = mean > 0 ? std::sqrt(variance) / mean : 0;
+    return spread;
+}
+
+}
+
+BENCHMARK_SUITE(codec, "Full StandardEncoder::encode()/StandardDecoder::decode() at capacity per image size, BPC and encoding")
+{
+    for(const QSize& dim : Bench::imageSizes(ctx.options().maxMegapixels))
+    {
+        const QImage medium = Bench::randomImage(dim);
+
+        for(Encoding enc : {Encoding::Absolute, Encoding::Relative})
+        {
+            for(quint8 bpc = BPC_MIN; bpc <= BPC_MAX; bpc++)
+            {
+                QString caseStr = u"%1 %2 bpc %3"_s.arg(Bench::sizeString(dim), ENUM_NAME(enc)).arg(bpc);
+
+                // Fill the image, but stay within what the payload length field allows
+                quint64 capacity = PxCrypt::StandardEncoder::calculateMaximumPayload(dim, TAG.size(), bpc);
+                qint64 size = std::min<quint64>(capacity, std::numeric_limits<quint32>::max());
+                const QByteArray payload = Bench::randomData(size);
+
+                PxCrypt::StandardEncoder encoder;
+                encoder.setBpc(bpc);
+                encoder.setEncoding(enc);
+                encoder.setPresharedKey(PSK);
+                encoder.setTag(TAG);
+                encoder.setThreadCount(ctx.options().threads);
+
+                PxCrypt::StandardDecoder decoder;
+                decoder.setPresharedKey(PSK);
+                decoder.setThreadCount(ctx.options().threads);
+
+                // Ensure the round trip works before bothering to time it
+                QImage encoded;
+                QByteArray decoded;
+                if(auto eErr = encoder.encode(encoded, payload, medium); eErr)
+                {
+                    ctx.fail(u"Encode failed for %1: %2"_s.arg(caseStr, eErr.errorString()));
+                    continue;
+                }
+                if(auto dErr = decoder.decode(decoded, encoded, medium); dErr || decoded != payload)
+                {
+                    ctx.fail(u"Decode failed for %1: %2"_s.arg(caseStr, dErr ? dErr.errorString() : u"payload mismatch"_s));
+                    continue;
+                }
+
+                ctx.measure(u"encode "_s + caseStr, u"B"_s, size, [&]{ encoder.encode(encoded, payload, medium); });
+                ctx.measure(u"decode "_s + caseStr, u"B"_s, size, [&]{ decoder.decode(decoded, encoded, medium); });
+            }
+        }
+    }
+}
+
+BENCHMARK_SUITE(read_order, "StandardDecoder::decode() at capacity reading in traversal order vs. memory order per image size, BPC and encoding")
+{
+    for(const QSize& dim : Bench::imageSizes(ctx.options().maxMegapixels))
+    {
+        const QImage medium = Bench::randomImage(dim);
+
+        for(Encoding enc : {Encoding::Absolute, Encoding::Relative})
+        {
+            for(quint8 bpc = BPC_MIN; bpc <= BPC_MAX; bpc++)
+            {
+                QString caseStr = u"%1 %2 bpc %3"_s.arg(Bench::sizeString(dim), ENUM_NAME(enc)).arg(bpc);
+
+                quint64 capacity = PxCrypt::StandardEncoder::calculateMaximumPayload(dim, TAG.size(), bpc);
+                qint64 size = std::min<quint64>(capacity, std::numeric_limits<quint32>::max());
+                const QByteArray payload = Bench::randomData(size);
+
+                PxCrypt::StandardEncoder encoder;
+                encoder.setBpc(bpc);
+                encoder.setEncoding(enc);
+                encoder.setPresharedKey(PSK);
+                encoder.setTag(TAG);
+                encoder.setThreadCount(ctx.options().threads);
+
+                QImage encoded;
+                if(auto eErr = encoder.encode(encoded, payload, medium); eErr)
+                {
+                    ctx.fail(u"Encode failed for %1: %2"_s.arg(caseStr, eErr.errorString()));
+                    continue;
+                }
+
+                for(ReadOrder order : {ReadOrder::TraversalOrder, ReadOrder::MemoryOrder})
+                {
+                    PxCrypt::StandardDecoder decoder;
+                    decoder.setPresharedKey(PSK);
+                    decoder.setThreadCount(ctx.options().threads);
+                    decoder.setReadOrder(order);
+
+                    // Both orders must produce the payload before bothering to time them
+                    QByteArray decoded;
+                    if(auto dErr = decoder.decode(decoded, encoded, medium); dErr || decoded != payload)
+                    {
+                        ctx.fail(u"Decode failed for %1 %2: %3"_s.arg(ENUM_NAME(order), caseStr, dErr ? dErr.errorString() : u"payload mismatch"_s));
+                        continue;
+                    }
+
+                    ctx.measure(u"decode %1 %2"_s.arg(ENUM_NAME(order), caseStr), u"B"_s, size, [&]{ decoder.decode(decoded, encoded, medium); });
+                }
+            }
+        }
+    }
+}
+
+BENCHMARK_SUITE(block_shuffle, "BlockShuffle vs. Permutation revision: throughput at capacity and spread of altered pixels at a quarter of capacity, per image size and encoding")
+{
+    const quint8 bpc = 3;
+
+    for(const QSize& dim : Bench::imageSizes(ctx.options().maxMegapixels))
+    {
+        const QImage medium = Bench::randomImage(dim);
+
+        for(Encoding enc : {Encoding::Absolute, Encoding::Relative})
+        {
+            quint64 capacity = PxCrypt::StandardEncoder::calculateMaximumPayload(dim, TAG.size(), bpc);
+            qint64 size = std::min<quint64>(capacity, std::numeric_limits<quint32>::max());
+            const QByteArray payload = Bench::randomData(size);
+            const QByteArray partial = payload.first(size / 4);
+
+            for(auto rev : {PxCrypt::Encoder::Permutation, PxCrypt::Encoder::BlockShuffle})
+            {
+                QString caseStr = u"%1 %2 (%3)"_s.arg(Bench::sizeString(dim), ENUM_NAME(enc), ENUM_NAME(rev));
+
+                PxCrypt::StandardEncoder encoder;
+                encoder.setBpc(bpc);
+                encoder.setEncoding(enc);
+                encoder.setRevision(rev);
+                encoder.setPresharedKey(PSK);
+                encoder.setTag(TAG);
+                encoder.setThreadCount(ctx.options().threads);
+
+                PxCrypt::StandardDecoder decoder;
+                decoder.setPresharedKey(PSK);
+                decoder.setThreadCount(ctx.options().threads);
+
+                // Ensure the round trip works before bothering to time it
+                QImage encoded;
+                QByteArray decoded;
+                if(auto eErr = encoder.encode(encoded, payload, medium); eErr)
+                {
+                    ctx.fail(u"Encode failed for %1: %2"_s.arg(caseStr, eErr.errorString()));
+                    continue;
+                }
+                if(auto dErr = decoder.decode(decoded, encoded, medium); dErr || decoded != payload)
+                {
+                    ctx.fail(u"Decode failed for %1: %2"_s.arg(caseStr, dErr ? dErr.errorString() : u"payload mismatch"_s));
+                    continue;
+                }
+
+                ctx.measure(u"encode "_s + caseStr, u"B"_s, size, [&]{ encoder.encode(encoded, payload, medium); });
+                ctx.measure(u"decode "_s + caseStr, u"B"_s, size, [&]{ decoder.decode(decoded, encoded, medium); });
+
+                // Distortion only differs in where it lands, which only shows when the image isn't full
+                QImage partialEncoded;
+                if(auto eErr = encoder.encode(partialEncoded, partial, medium); eErr)
+                {
+                    ctx.fail(u"Partial encode failed for %1: %2"_s.arg(caseStr, eErr.errorString()));
+                    continue;
+                }
+
+                ctx.measure(u"encode quarter "_s + caseStr, u"B"_s, partial.size(), [&]{ encoder.encode(partialEncoded, partial, medium); });
+                Spread spread = alteredSpread(medium, partialEncoded);
+                ctx.annotate(u"altered"_s, spread.altered);
+                ctx.annotate(u"tile_min"_s, spread.tileMin);
+                ctx.annotate(u"tile_max"_s, spread.tileMax);
+                ctx.annotate(u"tile_cv"_s, spread.tileCv);
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+// Qx Includes
+#include <qx/core/qx-integrity.h>
+
+// Project Includes
+#include "benchmark.h"
+#include "fixtures.h"
+#include "integrity/crc32.h"
+
+using namespace PxCryptPrivate;
+
+namespace
+{
+
+QString kernelName(Crc32::Kernel kernel)
+{
+    switch(kernel)
+    {
+        case Crc32::Kernel::Sliced: return u"sliced"_s;
+        case Crc32::Kernel::Pclmul: return u"pclmul"_s;
+        case Crc32::Kernel::Armv8: return u"armv8"_s;
+    }
+
+    return {};
+}
+
+}
+
+BENCHMARK_SUITE(crc32, "CRC-32 throughput (Qx reference vs. Crc32, per kernel, one-shot, chunked and combined) per buffer size")
+{
+    const QList<qint64> sizes{1024, 1024 * 1024, 64 * 1024 * 1024};
+    const QList<Crc32::Kernel> kernels{Crc32::Kernel::Sliced, Crc32::Kernel::Pclmul, Crc32::Kernel::Armv8};
+    const qint64 chunk = 64 * 1024;
+    const qint64 parts = 64;
+
+    for(qint64 size : sizes)
+    {
+        const QByteArray data = Bench::randomData(size);
+        QString caseStr = u"%1 B"_s.arg(size);
+
+        // Ensure the implementations agree before bothering to time them
+        quint32 expected = Qx::Integrity::crc32(data);
+        Crc32 chunked;
+        for(qint64 i = 0; i < size; i += chunk)
+            chunked.update(QByteArrayView(data).sliced(i, std::min(chunk, size - i)));
+
+        if(Crc32::compute(data) != expected || chunked.value() != expected)
+        {
+            ctx.fail(u"Checksum mismatch for "_s + caseStr);
+            continue;
+        }
+
+        ctx.measure(u"qx "_s + caseStr, u"B"_s, size, [&]{ Qx::Integrity::crc32(data); });
+        ctx.measure(u"one-shot "_s + caseStr, u"B"_s, size, [&]{ Crc32::compute(data); });
+        ctx.annotate(u"kernel"_s, kernelName(Crc32::kernel()));
+
+        for(Crc32::Kernel kernel : kernels)
+        {
+            if(!Crc32::isSupported(kernel))
+                continue;
+
+            QString kernelStr = kernelName(kernel);
+            if(Crc32::compute(data, kernel) != expected)
+            {
+                ctx.fail(u"Checksum mismatch with "_s + kernelStr + u" kernel for "_s + caseStr);
+                continue;
+            }
+
+            ctx.measure(kernelStr + u" "_s + caseStr, u"B"_s, size, [&]{ Crc32::compute(data, kernel); });
+        }
+
+        // As done by the multi-part encoder, which has each part's checksum already
+        const qint64 partSize = size / parts;
+        QList<quint32> partSums;
+        for(qint64 p = 0; p < parts; ++p)
+            partSums.append(Crc32::compute(QByteArrayView(data).sliced(p * partSize, p == parts - 1 ? size - p * partSize : partSize)));
+
+        auto combineParts = [&]{
+            quint32 crc = 0;
+            for(qint64 p = 0; p < parts; ++p)
+                crc = Crc32::combine(crc, partSums[p], p == parts - 1 ? size - p * partSize : partSize);
+            return crc;
+        };
+
+        if(combineParts() != expected)
+        {
+            ctx.fail(u"Combined checksum mismatch for "_s + caseStr);
+            continue;
+        }
+
+        ctx.measure(u"combine %1 parts "_s.arg(parts) + caseStr, u"part"_s, parts, combineParts);
+        ctx.measure(u"chunked "_s + caseStr, u"B"_s, size, [&]{
+            Crc32 crc;
+            for(qint64 i = 0; i < size; i += chunk)
+                crc.update(QByteArrayView(data).sliced(i, std::min(chunk, size - i)));
+        });
+    }
+}
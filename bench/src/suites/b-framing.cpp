@@ -0,0 +1,78 @@
+// Qt Includes
+#include <QBuffer>
+#include <QImage>
+
+// Project Includes
+#include "benchmark.h"
+#include "fixtures.h"
+#include "art_io/works/standard.h"
+#include "art_io/works/multipart.h"
+#include "medium_io/canvas.h"
+
+using namespace PxCryptPrivate;
+using Encoding = PxCrypt::Encoder::Encoding;
+
+namespace
+{
+
+const QByteArray SEED = "Benchmark seed"_ba;
+const QSize DIM(512, 512);
+const QByteArray TAG = "benchmark.bin"_ba;
+
+/* Small payloads, so that the cost is dominated by what surrounds the payload: the magic number, IDs, lengths
+ * and checksums going through QDataStream, along with opening the canvas and locating the data.
+ */
+template<typename W>
+bool roundTrip(const QImage& base, const W& written, W& read)
+{
+    QImage image = base;
+    {
+        Canvas canvas(image, SEED);
+        canvas.setBpc(1);
+        canvas.setEncoding(Encoding::Absolute);
+        canvas.open(QIODevice::WriteOnly);
+        if(W(written).writeToCanvas(canvas))
+            return false;
+    }
+
+    Canvas canvas(image, SEED);
+    canvas.open(QIODevice::ReadOnly);
+    return !W::readFromCanvas(read, canvas);
+}
+
+}
+
+BENCHMARK_SUITE(framing, "Artwork framing through QDataStream (write + read of minimal standard and multi-part works)")
+{
+    const QImage base = Bench::randomImage(DIM);
+
+    for(qint64 size : {16, 1024})
+    {
+        QByteArray payload = Bench::randomData(size);
+        QString caseStr = u"%1 B"_s.arg(size);
+
+        // Standard
+        QBuffer source(&payload);
+        source.open(QIODevice::ReadOnly);
+        StandardWork standard(TAG, source, payload.size());
+        StandardWork standardRead;
+
+        if(!roundTrip(base, standard, standardRead) || standardRead.payload() != payload)
+            ctx.fail(u"Standard round trip failed for "_s + caseStr);
+        else
+        {
+            ctx.measure(u"standard "_s + caseStr, u"work"_s, 1, [&]{ source.seek(0); }, [&]{
+                roundTrip(base, standard, standardRead);
+            });
+        }
+
+        // Multi-part
+        MultiPartWork part(TAG, payload, 0, 0, 1);
+        MultiPartWork partRead;
+
+        if(!roundTrip(base, part, partRead) || partRead.partPayload() != payload)
+            ctx.fail(u"Multi-part round trip failed for "_s + caseStr);
+        else
+            ctx.measure(u"multi-part "_s + caseStr, u"work"_s, 1, [&]{ roundTrip(base, part, partRead); });
+    }
+}
@@ -0,0 +1,41 @@
+// Qt Includes
+#include <QImage>
+
+// Project Includes
+#include "benchmark.h"
+#include "fixtures.h"
+#include "codec/encdec.h"
+
+using namespace PxCryptPrivate;
+
+BENCHMARK_SUITE(standardize, "Medium standardization (standardizeImage) per source format and image size")
+{
+    // Formats that are accessed directly only cost the copy made before writing, the rest need a full conversion
+    const QList<std::pair<QString, QImage::Format>> formats{
+        {u"ARGB32"_s, QImage::Format_ARGB32},
+        {u"RGB888"_s, QImage::Format_RGB888},
+        {u"RGBA8888"_s, QImage::Format_RGBA8888},
+        {u"ARGB32_Premultiplied"_s, QImage::Format_ARGB32_Premultiplied},
+        {u"RGB16"_s, QImage::Format_RGB16},
+        {u"RGBA64"_s, QImage::Format_RGBA64},
+        {u"Indexed8"_s, QImage::Format_Indexed8}
+    };
+
+    for(const QSize& dim : Bench::imageSizes(ctx.options().maxMegapixels))
+    {
+        quint64 pixels = quint64(dim.width()) * dim.height();
+        const QImage argb = Bench::randomImage(dim);
+
+        for(const auto& [fmtName, fmt] : formats)
+        {
+            const QImage source = argb.convertToFormat(fmt);
+            QString caseStr = u"%1 %2"_s.arg(fmtName, Bench::sizeString(dim));
+
+            // Detach as encode() does before writing, so that the copy-on-write of direct formats is counted too
+            ctx.measure(caseStr, u"px"_s, pixels, [&]{
+                QImage std = standardizeImage(source);
+                std.bits();
+            });
+        }
+    }
+}
@@ -0,0 +1,69 @@
+// Qt Includes
+#include <QBuffer>
+#include <QImageWriter>
+
+// Project Includes
+#include "benchmark.h"
+#include "fixtures.h"
+#include "pxcrypt/codec/standard_encoder.h"
+
+BENCHMARK_SUITE(png, "PNG output compression time and size per utility --png-profile and image size")
+{
+    // Mirrors the utility's profiles
+    const QList<std::pair<QString, int>> profiles{
+        {u"store"_s, 0},
+        {u"fast"_s, 1},
+        {u"default"_s, -1},
+        {u"small"_s, 9}
+    };
+
+    for(const QSize& dim : Bench::imageSizes(ctx.options().maxMegapixels))
+    {
+        /* Real mediums are mostly smooth, which is what PNG does well on, while the woven payload adds noise to
+         * the low bits. A gradient encoded at a typical density gives sizes close to those of photos.
+         */
+        QImage medium(dim, QImage::Format_RGB32);
+        for(int y = 0; y < dim.height(); ++y)
+        {
+            QRgb* line = reinterpret_cast<QRgb*>(medium.scanLine(y));
+            for(int x = 0; x < dim.width(); ++x)
+                line[x] = qRgb(x * 255 / dim.width(), y * 255 / dim.height(), (x + y) * 127 / (dim.width() + dim.height()));
+        }
+
+        PxCrypt::StandardEncoder encoder;
+        encoder.setBpc(2);
+        encoder.setEncoding(PxCrypt::Encoder::Absolute);
+        const QByteArray payload = Bench::randomData(PxCrypt::StandardEncoder::calculateMaximumPayload(dim, 0, 2));
+
+        QImage encoded;
+        if(auto err = encoder.encode(encoded, payload, medium))
+        {
+            ctx.fail(u"Encode failed for %1: %2"_s.arg(Bench::sizeString(dim), err.errorString()));
+            continue;
+        }
+
+        quint64 pixels = quint64(dim.width()) * dim.height();
+        quint64 rawBytes = encoded.sizeInBytes();
+        for(const auto& [profile, level] : profiles)
+        {
+            QByteArray out;
+            bool written = true;
+            ctx.measure(u"%1 %2"_s.arg(profile, Bench::sizeString(dim)), u"px"_s, pixels, [&]{ out.clear(); }, [&]{
+                QBuffer buffer(&out);
+                buffer.open(QIODevice::WriteOnly);
+                QImageWriter writer(&buffer, "png");
+                writer.setCompression(level);
+                written = written && writer.write(encoded);
+            });
+
+            if(!written)
+            {
+                ctx.fail(u"Write failed for %1 %2"_s.arg(profile, Bench::sizeString(dim)));
+                continue;
+            }
+
+            ctx.annotate(u"bytes"_s, static_cast<qint64>(out.size()));
+            ctx.annotate(u"ratio"_s, double(out.size()) / rawBytes);
+        }
+    }
+}
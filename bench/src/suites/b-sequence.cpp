@@ -0,0 +1,185 @@
+// Standard Library Includes
+#include <random>
+
+// Qt Includes
+#include <QRandomGenerator>
+#include <QSize>
+#include <QVarLengthArray>
+
+// Qx Includes
+#include <qx/core/qx-freeindextracker.h>
+
+// Project Includes
+#include "benchmark.h"
+#include "integrity/crc32.h"
+#include "medium_io/sequence/px_schedule.h"
+#include "medium_io/sequence/px_schedule_cache.h"
+#include "medium_io/sequence/px_sequence_generator.h"
+#include "medium_io/sequence/ch_sequence_generator.h"
+
+using namespace PxCryptPrivate;
+
+namespace
+{
+
+const QByteArray SEED = "Benchmark seed"_ba;
+
+// The pixel sequence as originally generated, kept as the reference for both speed and ordering
+std::vector<quint64> trackerOrder(const QSize& dim, quint64 count)
+{
+    QRandomGenerator generator;
+    std::seed_seq ss(SEED.cbegin(), SEED.cend());
+    generator.seed(ss);
+
+    Qx::FreeIndexTracker tracker(0, (dim.width() * dim.height()) - 1);
+    std::vector<quint64> order;
+    order.reserve(count);
+    for(quint64 i = 0; i < count; ++i)
+    {
+        quint64 naturalIdx = generator.bounded(tracker.maximum() + 1);
+        order.push_back(tracker.reserveNearestFree(naturalIdx).value());
+    }
+
+    return order;
+}
+
+std::vector<quint64> scheduleOrder(const QSize& dim, quint64 count)
+{
+    PxSchedule schedule(dim, SEED);
+    schedule.materialize(count);
+
+    std::vector<quint64> order;
+    order.reserve(count);
+    for(quint64 i = 0; i < count; ++i)
+        order.push_back(schedule.at(i));
+
+    return order;
+}
+
+// The channel sequence as originally generated, drawing each channel from those left in the pixel
+std::vector<Channel> trackerChannels(quint64 pixels)
+{
+    QRandomGenerator generator(Crc32::compute(SEED));
+    std::vector<Channel> order;
+    order.reserve(pixels * 3);
+    for(quint64 i = 0; i < pixels; ++i)
+    {
+        QVarLengthArray<Channel, 3> unused{Channel::Red, Channel::Green, Channel::Blue};
+        while(!unused.isEmpty())
+        {
+            auto rem = unused.size();
+            quint32 idx = rem == 1 ? 0 : generator.bounded(rem);
+            order.push_back(unused[idx]);
+            unused.remove(idx);
+        }
+    }
+
+    return order;
+}
+
+std::vector<Channel> generatorChannels(quint64 pixels, ChSequenceGenerator::Ordering ordering)
+{
+    ChSequenceGenerator generator(SEED, ordering);
+    std::vector<Channel> order;
+    order.reserve(pixels * 3);
+    for(quint64 i = 0; i < pixels * 3; ++i)
+        order.push_back(generator.next());
+
+    return order;
+}
+
+}
+
+BENCHMARK_SUITE(sequence, "Pixel sequence generation (FreeIndexTracker vs. PxSchedule engines) at varying capacity")
+{
+    const QList<QSize> dims{{1000, 1000}, {2000, 2000}};
+    const QList<int> fills{10, 50, 99};
+
+    for(const QSize& dim : dims)
+    {
+        quint64 total = quint64(dim.width()) * dim.height();
+        QString dimStr = u"%1x%2"_s.arg(dim.width()).arg(dim.height());
+
+        for(int fill : fills)
+        {
+            quint64 count = total * fill / 100;
+            QString caseStr = u"%1 @ %2%"_s.arg(dimStr).arg(fill);
+
+            // Ensure the orders match before bothering to time them
+            if(trackerOrder(dim, count) != scheduleOrder(dim, count))
+            {
+                ctx.fail(u"Sequence mismatch for "_s + caseStr);
+                continue;
+            }
+
+            ctx.measure(u"tracker "_s + caseStr, u"px"_s, count, [&]{ trackerOrder(dim, count); });
+            ctx.measure(u"schedule "_s + caseStr, u"px"_s, count, [&]{
+                PxSchedule schedule(dim, SEED);
+                schedule.materialize(count);
+            });
+            ctx.measure(u"schedule (xoshiro) "_s + caseStr, u"px"_s, count, [&]{
+                PxSchedule schedule(dim, SEED, PxSchedule::Engine::Xoshiro);
+                schedule.materialize(count);
+            });
+            ctx.measure(u"schedule (feistel) "_s + caseStr, u"px"_s, count, [&]{
+                // Nothing is materialized, so every position has to actually be looked up
+                PxSchedule schedule(dim, SEED, PxSchedule::Engine::Feistel);
+                std::vector<quint64> order(count);
+                for(quint64 i = 0; i < count; ++i)
+                    order[i] = schedule.at(i);
+            });
+            ctx.measure(u"schedule (blocked) "_s + caseStr, u"px"_s, count, [&]{
+                PxSchedule schedule(dim, SEED, PxSchedule::Engine::Blocked);
+                std::vector<quint64> order(count);
+                for(quint64 i = 0; i < count; ++i)
+                    order[i] = schedule.at(i);
+            });
+        }
+    }
+}
+
+BENCHMARK_SUITE(channels, "Channel sequence generation (per-channel draws vs. permutation table) per pixel count")
+{
+    const QList<quint64> counts{1'000'000, 4'000'000};
+
+    for(quint64 pixels : counts)
+    {
+        QString countStr = QString::number(pixels);
+
+        // Drawn ordering must reproduce the original sequence exactly, otherwise existing images are lost
+        if(trackerChannels(pixels) != generatorChannels(pixels, ChSequenceGenerator::Ordering::Drawn))
+        {
+            ctx.fail(u"Channel sequence mismatch for "_s + countStr);
+            continue;
+        }
+
+        ctx.measure(u"tracker "_s + countStr, u"px"_s, pixels, [&]{ trackerChannels(pixels); });
+        ctx.measure(u"drawn "_s + countStr, u"px"_s, pixels, [&]{ generatorChannels(pixels, ChSequenceGenerator::Ordering::Drawn); });
+        ctx.measure(u"tabled "_s + countStr, u"px"_s, pixels, [&]{ generatorChannels(pixels, ChSequenceGenerator::Ordering::Tabled); });
+        ctx.measure(u"keyed "_s + countStr, u"px"_s, pixels, [&]{ generatorChannels(pixels, ChSequenceGenerator::Ordering::Keyed); });
+    }
+}
+
+BENCHMARK_SUITE(schedule_cache, "Pixel sequence startup for a new medium with and without a cached schedule")
+{
+    const QList<QSize> dims{{1000, 1000}, {4000, 3000}};
+
+    for(const QSize& dim : dims)
+    {
+        // About what a typical payload spread over the medium would need
+        quint64 count = quint64(dim.width()) * dim.height() / 4;
+        QString dimStr = u"%1x%2"_s.arg(dim.width()).arg(dim.height());
+
+        auto walk = [&](PxScheduleCache* cache){
+            PxSequenceGenerator generator(dim, SEED, PxSchedule::Engine::Mersenne, cache);
+            generator.prepare(count - 1);
+        };
+
+        // As with a multi-part operation, where the first medium of a size primes the cache for the rest
+        PxScheduleCache cache;
+        walk(&cache);
+
+        ctx.measure(u"uncached "_s + dimStr, u"px"_s, count, [&]{ walk(nullptr); });
+        ctx.measure(u"cached "_s + dimStr, u"px"_s, count, [&]{ walk(&cache); });
+    }
+}
@@ -0,0 +1,97 @@
+// Qt Includes
+#include <QImage>
+#include <QRandomGenerator>
+
+// Project Includes
+#include "benchmark.h"
+#include "fixtures.h"
+#include "pxcrypt/codec/encoder.h"
+#include "medium_io/operate/meta_access.h"
+#include "medium_io/traverse/canvas_traverser.h"
+
+using namespace PxCryptPrivate;
+
+namespace
+{
+
+const QByteArray SEED = "Benchmark seed"_ba;
+
+// Walks the whole canvas a channel at a time, as the byte-wise translation does
+quint64 walkChannels(CanvasTraverser& traverser)
+{
+    quint64 sum = 0;
+    while(!traverser.atEnd())
+    {
+        sum += traverser.pixelIndex() + traverser.channel();
+        traverser.advanceBits(traverser.remainingChannelBits());
+    }
+
+    return sum;
+}
+
+// Walks the whole canvas a pixel at a time, as the bulk translation does
+quint64 walkPixels(CanvasTraverser& traverser, quint8 bpc)
+{
+    quint64 sum = 0;
+    while(traverser.remainingBits() >= 3u * bpc)
+    {
+        CanvasTraverser::PixelSelection sel = traverser.takePixel();
+        sum += sel.px + sel.channels[0];
+    }
+
+    return sum;
+}
+
+}
+
+BENCHMARK_SUITE(traverse, "Canvas traversal (channel-wise and pixel-wise walks, random seeks) per image size")
+{
+    const quint8 bpc = 3;
+
+    for(const QSize& dim : Bench::imageSizes(ctx.options().maxMegapixels))
+    {
+        QImage image(dim, QImage::Format_ARGB32);
+        quint64 pixels = quint64(dim.width()) * dim.height();
+        QString dimStr = Bench::sizeString(dim);
+
+        MetaAccess meta(image, SEED);
+        meta.setBpc(bpc);
+        meta.setRev(PxCrypt::Encoder::Original);
+        CanvasTraverser traverser(meta);
+
+        // Walk once up front so that schedule materialization isn't attributed to whichever case runs first
+        traverser.init();
+        walkChannels(traverser);
+
+        for(auto rev : {PxCrypt::Encoder::Original, PxCrypt::Encoder::ChannelTable, PxCrypt::Encoder::FastRng, PxCrypt::Encoder::Permutation, PxCrypt::Encoder::BlockShuffle})
+        {
+            // Revisions with their own pixel engine get a new schedule, which also needs materializing up front
+            meta.setRev(rev);
+            traverser.init();
+            walkChannels(traverser);
+
+            QString caseStr = dimStr + u" ("_s + ENUM_NAME(rev) + u")"_s;
+            ctx.measure(u"walk channels "_s + caseStr, u"px"_s, pixels, [&]{ traverser.init(); }, [&]{ walkChannels(traverser); });
+            ctx.measure(u"walk pixels "_s + caseStr, u"px"_s, pixels, [&]{ traverser.init(); }, [&]{ walkPixels(traverser, bpc); });
+        }
+
+        // Back to the original schedule, which was replaced along the way
+        meta.setRev(PxCrypt::Encoder::Original);
+        traverser.init();
+        walkChannels(traverser);
+
+        // Seeks land on arbitrary bits, as fill() and parallel forks do
+        const int seeks = 100'000;
+        traverser.init();
+        quint64 end = traverser.remainingBits();
+        QList<quint64> targets(seeks);
+        QRandomGenerator gen(3);
+        for(quint64& t : targets)
+            t = gen.bounded(end);
+
+        ctx.measure(u"random seek "_s + dimStr, u"seek"_s, seeks, [&]{
+            for(quint64 t : std::as_const(targets))
+                traverser.seek(t);
+        });
+    }
+}
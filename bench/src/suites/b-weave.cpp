@@ -0,0 +1,202 @@
+// Standard Library Includes
+#include <cstring>
+
+// Qt Includes
+#include <QImage>
+
+// Qx Includes
+#include <qx/core/qx-algorithm.h>
+
+// Project Includes
+#include "benchmark.h"
+#include "fixtures.h"
+#include "pxcrypt/codec/encoder.h"
+#include "medium_io/operate/meta_access.h"
+#include "medium_io/operate/px_access.h"
+#include "medium_io/operate/data_translator.h"
+
+using namespace PxCryptPrivate;
+using Encoding = PxCrypt::Encoder::Encoding;
+
+namespace
+{
+
+const QByteArray SEED = "Benchmark seed"_ba;
+const QSize DIM(2048, 2048);
+
+// The byte-wise translation as originally implemented, which decided BPC and encoding at runtime per bit group
+class LegacyTranslator
+{
+    PxAccess& mAccess;
+
+    template<typename F>
+    bool translate(F procedure)
+    {
+        int byteBitIdx = 0;
+        while(byteBitIdx < 8 && !mAccess.atEnd())
+        {
+            int processing = std::min(8 - byteBitIdx, mAccess.availableBits());
+            procedure(processing, byteBitIdx);
+            byteBitIdx += processing;
+            mAccess.advanceBits(processing);
+        }
+
+        return byteBitIdx == 8;
+    }
+
+public:
+    LegacyTranslator(PxAccess& access) : mAccess(access) {}
+
+    bool weaveByte(quint8 byte)
+    {
+        return translate([byte, this](int weaving, int alreadyWoven){
+            int chBitIdx = mAccess.bitIndex();
+            quint8 bits = ((byte >> alreadyWoven) & ((1 << weaving) - 1)) << chBitIdx;
+            quint8& val = mAccess.bufferedValue();
+            if(mAccess.hasReferenceImage())
+            {
+                if(mAccess.originalValue() > 127)
+                    val -= bits;
+                else
+                    val += bits;
+            }
+            else
+            {
+                quint8 clearMask = ~(((0b1 << weaving) - 1) << chBitIdx);
+                val = (val & clearMask) | bits;
+            }
+        });
+    }
+
+    bool skimByte(quint8& byte)
+    {
+        byte = 0;
+        return translate([&byte, this](int skimming, int alreadySkimmed){
+            int chBitIdx = mAccess.bitIndex();
+            quint8 keepMask = ((0b1 << skimming) - 1) << chBitIdx;
+            quint8 bits = mAccess.hasReferenceImage() ? Qx::distance(mAccess.referenceValue(), mAccess.constBufferedValue()) & keepMask :
+                                                        mAccess.constBufferedValue() & keepMask;
+            byte |= (bits >> chBitIdx) << alreadySkimmed;
+        });
+    }
+};
+
+// The same arrangement Canvas uses, without the QIODevice layer
+struct Rig
+{
+    QImage canvas;
+    MetaAccess meta;
+    PxAccess access;
+    std::unique_ptr<DataTranslator> translator;
+    LegacyTranslator legacy;
+
+    Rig(const QImage& base, quint8 bpc, Encoding enc) :
+        canvas(base.copy()),
+        meta(canvas, SEED),
+        access(canvas, meta),
+        legacy(access)
+    {
+        meta.setBpc(bpc);
+        meta.setEnc(enc);
+        if(enc == Encoding::Relative)
+            access.setReferenceImage(&base);
+        access.reset();
+        translator = DataTranslator::create(access, bpc, enc);
+    }
+
+    void restore(const QImage& base)
+    {
+        std::memcpy(canvas.bits(), base.constBits(), base.sizeInBytes());
+        access.reset();
+    }
+
+    void weaveLegacy(const QByteArray& data)
+    {
+        for(char b : data)
+            legacy.weaveByte(static_cast<quint8>(b));
+        access.flush();
+    }
+
+    void weaveBytewise(const QByteArray& data)
+    {
+        for(char b : data)
+            translator->weaveByte(static_cast<quint8>(b));
+        access.flush();
+    }
+
+    void weaveBulk(const QByteArray& data)
+    {
+        translator->weave(reinterpret_cast<const quint8*>(data.constData()), data.size());
+        access.flush();
+    }
+
+    QByteArray skimLegacy(qint64 size)
+    {
+        QByteArray data(size, Qt::Uninitialized);
+        for(char& b : data)
+            legacy.skimByte(reinterpret_cast<quint8&>(b));
+        return data;
+    }
+
+    QByteArray skimBytewise(qint64 size)
+    {
+        QByteArray data(size, Qt::Uninitialized);
+        for(char& b : data)
+            translator->skimByte(reinterpret_cast<quint8&>(b));
+        return data;
+    }
+
+    QByteArray skimBulk(qint64 size)
+    {
+        QByteArray data(size, Qt::Uninitialized);
+        translator->skim(reinterpret_cast<quint8*>(data.data()), size);
+        return data;
+    }
+};
+
+}
+
+BENCHMARK_SUITE(weave, "Payload weaving/skimming throughput per BPC and encoding (legacy vs. specialized byte-wise vs. bulk)")
+{
+    const QImage base = Bench::randomImage(DIM);
+
+    for(Encoding enc : {Encoding::Absolute, Encoding::Relative})
+    {
+        for(quint8 bpc = BPC_MIN; bpc <= BPC_MAX; bpc++)
+        {
+            QString caseStr = u"%1 bpc %2"_s.arg(ENUM_NAME(enc)).arg(bpc);
+
+            Rig legacyRig(base, bpc, enc);
+            Rig byteRig(base, bpc, enc);
+            Rig bulkRig(base, bpc, enc);
+            qint64 size = byteRig.access.remainingBits() / 8;
+            const QByteArray payload = Bench::randomData(size);
+
+            // Ensure the paths agree before bothering to time them
+            legacyRig.weaveLegacy(payload);
+            byteRig.weaveBytewise(payload);
+            bulkRig.weaveBulk(payload);
+            if(byteRig.canvas != legacyRig.canvas || bulkRig.canvas != legacyRig.canvas)
+            {
+                ctx.fail(u"Weave mismatch for "_s + caseStr);
+                continue;
+            }
+
+            legacyRig.access.reset();
+            byteRig.access.reset();
+            bulkRig.access.reset();
+            if(legacyRig.skimLegacy(size) != payload || byteRig.skimBytewise(size) != payload || bulkRig.skimBulk(size) != payload)
+            {
+                ctx.fail(u"Skim mismatch for "_s + caseStr);
+                continue;
+            }
+
+            ctx.measure(u"weave legacy "_s + caseStr, u"B"_s, size, [&]{ legacyRig.restore(base); }, [&]{ legacyRig.weaveLegacy(payload); });
+            ctx.measure(u"weave byte-wise "_s + caseStr, u"B"_s, size, [&]{ byteRig.restore(base); }, [&]{ byteRig.weaveBytewise(payload); });
+            ctx.measure(u"weave bulk "_s + caseStr, u"B"_s, size, [&]{ bulkRig.restore(base); }, [&]{ bulkRig.weaveBulk(payload); });
+            ctx.measure(u"skim legacy "_s + caseStr, u"B"_s, size, [&]{ legacyRig.access.reset(); }, [&]{ legacyRig.skimLegacy(size); });
+            ctx.measure(u"skim byte-wise "_s + caseStr, u"B"_s, size, [&]{ byteRig.access.reset(); }, [&]{ byteRig.skimBytewise(size); });
+            ctx.measure(u"skim bulk "_s + caseStr, u"B"_s, size, [&]{ bulkRig.access.reset(); }, [&]{ bulkRig.skimBulk(size); });
+        }
+    }
+}
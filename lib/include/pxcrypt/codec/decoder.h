@@ -16,6 +16,14 @@ class DecoderPrivate;
 class PXCRYPT_CODEC_EXPORT Decoder
 {
     Q_DECLARE_PRIVATE(Decoder);
+//-Class Enums--------------------------------------------------------------------------------------------------
+public:
+    enum ReadOrder : quint8
+    {
+        TraversalOrder,
+        MemoryOrder
+    };
+
 //-Instance Variables----------------------------------------------------------------------------------------------
 /*! @cond */
 protected:
@@ -35,7 +43,12 @@ public:
 //-Instance Functions----------------------------------------------------------------------------------------------
 public:
     QByteArray presharedKey() const;
+    int threadCount() const;
+    ReadOrder readOrder() const;
+
     void setPresharedKey(const QByteArray& key);
+    void setThreadCount(int threads);
+    void setReadOrder(ReadOrder order);
 };
 
 }
@@ -27,6 +27,15 @@ public:
         Absolute
     };
 
+    enum Revision : quint8
+    {
+        Original,
+        ChannelTable,
+        FastRng,
+        Permutation,
+        BlockShuffle
+    };
+
 //-Instance Variables----------------------------------------------------------------------------------------------
 /*! @cond */
 protected:
@@ -47,11 +56,15 @@ public:
 public:
     quint8 bpc() const;
     Encoding encoding() const;
+    Revision revision() const;
     QByteArray presharedKey() const;
+    int threadCount() const;
 
     void setBpc(quint8 bpc);
     void setEncoding(Encoding enc);
+    void setRevision(Revision rev);
     void setPresharedKey(const QByteArray& key);
+    void setThreadCount(int threads);
 };
 
 }
@@ -0,0 +1,53 @@
+#ifndef IMAGE_SOURCE_H
+#define IMAGE_SOURCE_H
+
+// Shared Library Support
+#include "pxcrypt/pxcrypt_codec_export.h"
+
+// Standard Library Includes
+#include <memory>
+
+// Qt Includes
+#include <QImage>
+
+class QIODevice;
+
+namespace PxCrypt
+{
+
+class ImageSourcePrivate;
+
+class PXCRYPT_CODEC_EXPORT ImageSource
+{
+    Q_DECLARE_PRIVATE(ImageSource);
+//-Instance Variables----------------------------------------------------------------------------------------------
+private:
+    std::unique_ptr<ImageSourcePrivate> d_ptr;
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    ImageSource(const QImage& image);
+    ImageSource(const QString& filePath);
+    ImageSource(QIODevice* device);
+    ImageSource(const ImageSource& other);
+    ImageSource(ImageSource&& other) noexcept;
+
+//-Destructor---------------------------------------------------------------------------------------------------
+public:
+    ~ImageSource();
+
+//-Instance Functions----------------------------------------------------------------------------------------------
+public:
+    bool isLoaded() const;
+    QSize size(QString* errorString = nullptr) const;
+    QImage load(QString* errorString = nullptr) const;
+
+//-Operators----------------------------------------------------------------------------------------------------------
+public:
+    ImageSource& operator=(const ImageSource& other);
+    ImageSource& operator=(ImageSource&& other) noexcept;
+};
+
+}
+
+#endif // IMAGE_SOURCE_H
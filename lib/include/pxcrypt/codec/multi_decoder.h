@@ -6,12 +6,14 @@
 
 // Qt Includes
 #include <QImage>
+#include <QIODevice>
 
 // Qx Includes
 #include <qx/core/qx-abstracterror.h>
 
 // Project Includes
 #include "pxcrypt/codec/decoder.h"
+#include "pxcrypt/codec/image_source.h"
 
 namespace PxCrypt
 {
@@ -33,6 +35,7 @@ public:
 public:
     QString tag() const;
     Error decode(QByteArray& decoded, const QList<QImage>& encoded, const QList<QImage>& mediums = {});
+    Error decode(QIODevice& decoded, const QList<ImageSource>& encoded, const QList<ImageSource>& mediums = {});
 };
 
 class PXCRYPT_CODEC_EXPORT QX_ERROR_TYPE(MultiDecoder::Error, "PxCrypt::MultiDecoder::Error", 6879)
@@ -4,6 +4,9 @@
 // Shared Library Support
 #include "pxcrypt/pxcrypt_codec_export.h"
 
+// Standard Library Includes
+#include <functional>
+
 // Qt Includes
 #include <QImage>
 
@@ -12,6 +15,7 @@
 
 // Project Includes
 #include "pxcrypt/codec/encoder.h"
+#include "pxcrypt/codec/image_source.h"
 
 namespace PxCrypt
 {
@@ -25,22 +29,29 @@ class PXCRYPT_CODEC_EXPORT MultiEncoder final : public Encoder
 public:
     class Error;
 
+//-Aliases----------------------------------------------------------------------------------------------------------
+public:
+    using EncodedSink = std::function<bool(qsizetype index, const QImage& encoded)>;
+
 //-Constructor---------------------------------------------------------------------------------------------------
 public:
     MultiEncoder();
 
 //-Class Functions----------------------------------------------------------------------------------------------
 public:
-    static quint64 calculateMaximumPayload(const QList<QSize>& dims, quint16 tagSize, quint8 bpc);
-    static quint8 calculateOptimalDensity(const QList<QSize>& dims, quint16 tagSize, quint32 payloadSize);
+    static quint64 calculateMaximumPayload(const QList<QSize>& dims, quint16 tagSize, quint8 bpc, Revision rev = Original);
+    static quint8 calculateOptimalDensity(const QList<QSize>& dims, quint16 tagSize, quint32 payloadSize, Revision rev = Original);
 
 //-Instance Functions----------------------------------------------------------------------------------------------
 public:
     QString tag() const;
+    int imageConcurrency() const;
 
     void setTag(const QByteArray& tag);
+    void setImageConcurrency(int images);
 
     Error encode(QList<QImage>& encoded, QByteArrayView payload, const QList<QImage>& mediums);
+    Error encode(QByteArrayView payload, const QList<ImageSource>& mediums, const EncodedSink& sink);
 };
 
 class PXCRYPT_CODEC_EXPORT QX_ERROR_TYPE(MultiEncoder::Error, "PxCrypt::MultiEncoder::Error", 6979)
@@ -55,7 +66,8 @@ public:
         InvalidImage,
         WontFit,
         InvalidBpc,
-        WeaveFailed
+        WeaveFailed,
+        SinkFailed
     };
 
 //-Class Variables-------------------------------------------------------------
@@ -68,7 +80,8 @@ private:
         {InvalidImage, u"A medium is invalid."_s},
         {WontFit, u"A medium's dimensions are not large enough to fit the payload."_s},
         {InvalidBpc, u"Bits-per-channel must be between 1 and 7."_s},
-        {WeaveFailed, u"There was an error while weaving data."_s}
+        {WeaveFailed, u"There was an error while weaving data."_s},
+        {SinkFailed, u"An encoded image could not be handed off."_s}
     };
     //FIX ME: Make correct
 
@@ -6,6 +6,7 @@
 
 // Qt Includes
 #include <QImage>
+#include <QIODevice>
 
 // Qx Includes
 #include <qx/core/qx-abstracterror.h>
@@ -33,6 +34,7 @@ public:
 public:
     QString tag() const;
     Error decode(QByteArray& decoded, const QImage& encoded, const QImage& medium = QImage());
+    Error decode(QIODevice& decoded, const QImage& encoded, const QImage& medium = QImage());
 };
 
 class PXCRYPT_CODEC_EXPORT QX_ERROR_TYPE(StandardDecoder::Error, "PxCrypt::StandardDecoder::Error", 6878)
@@ -6,6 +6,7 @@
 
 // Qt Includes
 #include <QImage>
+#include <QIODevice>
 
 // Qx Includes
 #include <qx/core/qx-abstracterror.h>
@@ -31,8 +32,8 @@ public:
 
 //-Class Functions----------------------------------------------------------------------------------------------
 public:
-    static quint64 calculateMaximumPayload(const QSize& dim, quint16 tagSize, quint8 bpc);
-    static quint8 calculateOptimalDensity(const QSize& dim, quint16 tagSize, quint32 payloadSize);
+    static quint64 calculateMaximumPayload(const QSize& dim, quint16 tagSize, quint8 bpc, Revision rev = Original);
+    static quint8 calculateOptimalDensity(const QSize& dim, quint16 tagSize, quint32 payloadSize, Revision rev = Original);
 
 //-Instance Functions----------------------------------------------------------------------------------------------
 public:
@@ -41,6 +42,9 @@ public:
     void setTag(const QByteArray& tag);
 
     Error encode(QImage& encoded, QByteArrayView payload, const QImage& medium);
+    Error encode(QImage& encoded, QIODevice& payloadSource, qint64 size, const QImage& medium);
+    Error encodeInPlace(QImage& image, QByteArrayView payload);
+    Error encodeInPlace(QImage& image, QIODevice& payloadSource, qint64 size);
 };
 
 class PXCRYPT_CODEC_EXPORT QX_ERROR_TYPE(StandardEncoder::Error, "PxCrypt::StandardEncoder::Error", 6978)
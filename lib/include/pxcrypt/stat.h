@@ -7,6 +7,9 @@
 // Qt Includes
 #include <QImage>
 
+// Project Includes
+#include "pxcrypt/codec/encoder.h"
+
 namespace PxCrypt
 {
 
@@ -38,9 +41,9 @@ public:
 
 //-Instance Functions----------------------------------------------------------------------------------------------
 public:
-    Capacity capacity(quint8 bpc) const;
+    Capacity capacity(quint8 bpc, Encoder::Revision rev = Encoder::Original) const;
     bool fitsMetadata() const;
-    quint8 minimumDensity(quint64 bytes) const;
+    quint8 minimumDensity(quint64 bytes, Encoder::Revision rev = Encoder::Original) const;
 };
 
 }
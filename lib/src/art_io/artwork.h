@@ -1,6 +1,9 @@
 #ifndef ARTWORK_H
 #define ARTWORK_H
 
+// Standard Library Includes
+#include <utility>
+
 // Qt Includes
 #include <QByteArray>
 
@@ -63,8 +66,8 @@ protected:
 public:
     static ArtworkError readFromCanvas(DerivedT& art, Canvas& canvas)
     {
-        // Null out return buffer
-        art = DerivedT();
+        // Null out return buffer, but read into what it was, which may carry read configuration (e.g. a payload sink)
+        DerivedT readArt = std::exchange(art, DerivedT());
 
         // Setup stream
         QDataStream canvasStream(&canvas);
@@ -83,11 +86,10 @@ public:
                                                                                     .arg(RENDITION_ID, 2, 16, QChar(u'0')));
 
         // Setup new artwork
-        DerivedT readArt;
         Artwork& readArtBase = static_cast<Artwork&>(readArt); // TODO: WTF is this cast for???
 
         // Read rendition portion
-        ArtworkError renditionError = readArtBase.renditionRead(canvasStream);
+        ArtworkError renditionError = readArtBase.renditionRead(canvasStream, canvas);
 
         // Check stream
         QDataStream::Status ss = canvasStream.status();
@@ -105,8 +107,9 @@ public:
 
 //-Instance Functions----------------------------------------------------------------------------------------------
 protected:
-    virtual ArtworkError renditionRead(QDataStream& stream) = 0;
-    virtual ArtworkError renditionWrite(QDataStream& stream) const = 0;
+    // Canvas is the stream's device, and should be used directly for bulk data (i.e. payloads)
+    virtual ArtworkError renditionRead(QDataStream& stream, Canvas& canvas) = 0;
+    virtual ArtworkError renditionWrite(QDataStream& stream, Canvas& canvas) const = 0;
 
 public:
     ArtworkError writeToCanvas(Canvas& canvas)
@@ -120,7 +123,7 @@ public:
         canvasStream << RENDITION_ID;
 
         // Write rendition portion
-        ArtworkError renditionError = renditionWrite(canvasStream);
+        ArtworkError renditionError = renditionWrite(canvasStream, canvas);
 
         // Check stream
         QDataStream::Status ss = canvasStream.status();
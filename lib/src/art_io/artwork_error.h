@@ -20,7 +20,8 @@ public:
         NotMagic,
         WrongCodec,
         DataStreamError,
-        IntegrityError
+        IntegrityError,
+        PayloadDeviceError
     };
 
 //-Class Variables-------------------------------------------------------------
@@ -30,7 +31,8 @@ private:
         {NotMagic, u"Image is not a magic image (missing magic number)."_s},
         {WrongCodec, u"Image created with a different codec than specified (mismatched rendition)."_s},
         {DataStreamError, u"An error occurred while streaming data from/to the canvas."_s},
-        {IntegrityError, u"A data integrity check failed while reading data."_s}
+        {IntegrityError, u"A data integrity check failed while reading data."_s},
+        {PayloadDeviceError, u"An error occurred while transferring the payload to/from its device."_s}
     };
 
 //-Instance Variables-------------------------------------------------------------
@@ -19,10 +19,14 @@ IMeasure::IMeasure() {}
 //-Instance Functions----------------------------------------------------------------------------------------------
 //Public:
 quint64 IMeasure::size() const { return IArtwork::size(renditionSize()); }
-Canvas::metavalue_t IMeasure::minimumBpc(const QSize& dim) const { return PxCrypt::Stat(dim).minimumDensity(size()); }
-quint64 IMeasure::leftOverSpace(const QSize& dim, Canvas::metavalue_t bpc) const
+Canvas::metavalue_t IMeasure::minimumBpc(const QSize& dim, PxCrypt::Encoder::Revision rev) const
 {
-    return PxCrypt::Stat(dim).capacity(bpc).bytes - size();
+    return PxCrypt::Stat(dim).minimumDensity(size(), rev);
+}
+
+quint64 IMeasure::leftOverSpace(const QSize& dim, Canvas::metavalue_t bpc, PxCrypt::Encoder::Revision rev) const
+{
+    return PxCrypt::Stat(dim).capacity(bpc, rev).bytes - size();
 }
 
 }
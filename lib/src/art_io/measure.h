@@ -22,8 +22,8 @@ protected:
 
 public:
     quint64 size() const;
-    Canvas::metavalue_t minimumBpc(const QSize& dim) const;
-    quint64 leftOverSpace(const QSize& dim, Canvas::metavalue_t bpc) const;
+    Canvas::metavalue_t minimumBpc(const QSize& dim, PxCrypt::Encoder::Revision rev = PxCrypt::Encoder::Original) const;
+    quint64 leftOverSpace(const QSize& dim, Canvas::metavalue_t bpc, PxCrypt::Encoder::Revision rev = PxCrypt::Encoder::Original) const;
 };
 
 template<typename T>
@@ -4,8 +4,8 @@
 // Qt Includes
 #include <QDataStream>
 
-// Qx Includes
-#include <qx/core/qx-integrity.h>
+// Project Includes
+#include "integrity/crc32.h"
 
 namespace PxCryptPrivate
 {
@@ -23,9 +23,9 @@ MultiPartWork::MultiPartWork() :
     mPartCount(0)
 {}
 
-MultiPartWork::MultiPartWork(const QByteArray& tag, const QByteArray& payload, checksum_t completeChecksum, part_idx_t partIdx, part_idx_t partCount) :
+MultiPartWork::MultiPartWork(const QByteArray& tag, const QByteArray& payload, checksum_t partChecksum, checksum_t completeChecksum, part_idx_t partIdx, part_idx_t partCount) :
     mTag(tag),
-    mPartChecksum(Qx::Integrity::crc32(payload)),
+    mPartChecksum(partChecksum),
     mCompleteCheckum(completeChecksum),
     mPartIdx(partIdx),
     mPartCount(partCount),
@@ -53,7 +53,7 @@ quint64 MultiPartWork::renditionSize(tag_length_t tagSize, payload_length_t payl
 //Private:
 quint64 MultiPartWork::renditionSize() const { return renditionSize(mTag.size(), mPartPayload.size()); }
 
-ArtworkError MultiPartWork::renditionRead(QDataStream& stream)
+ArtworkError MultiPartWork::renditionRead(QDataStream& stream, Canvas& canvas)
 {
     // Read Tag
     tag_length_t tl; stream >> tl;
@@ -68,17 +68,21 @@ ArtworkError MultiPartWork::renditionRead(QDataStream& stream)
 
     // Read payload
     payload_length_t pl; stream >> pl;
+    if(qint64 avail = canvas.bytesAvailable(); pl > avail)
+        return ArtworkError(ArtworkError::IntegrityError, u"The payload's length (%1) exceeds the space remaining (%2)."_s.arg(pl).arg(avail));
+
     mPartPayload.resize(pl);
-    stream.readRawData(mPartPayload.data(), pl);
+    if(canvas.skim(std::as_writable_bytes(std::span(mPartPayload.data(), mPartPayload.size()))) != pl)
+        return ArtworkError(ArtworkError::DataStreamError, u"Canvas ended before payload."_s);
 
     // Confirm checksum
-    if(auto sumCheck = Qx::Integrity::crc32(mPartPayload); sumCheck != mPartChecksum)
+    if(auto sumCheck = Crc32::compute(mPartPayload); sumCheck != mPartChecksum)
         return ArtworkError(ArtworkError::IntegrityError, u"The payload's checksum did not match its record."_s);
 
     return ArtworkError();
 }
 
-ArtworkError MultiPartWork::renditionWrite(QDataStream& stream) const
+ArtworkError MultiPartWork::renditionWrite(QDataStream& stream, Canvas& canvas) const
 {
     // Write Tag
     stream << static_cast<tag_length_t>(mTag.size());
@@ -92,7 +96,8 @@ ArtworkError MultiPartWork::renditionWrite(QDataStream& stream) const
 
     // Write Payload
     stream << static_cast<payload_length_t>(mPartPayload.size());
-    stream.writeRawData(mPartPayload.constData(), mPartPayload.size());
+    if(canvas.weave(std::as_bytes(std::span(mPartPayload.constData(), mPartPayload.size()))) != mPartPayload.size())
+        return ArtworkError(ArtworkError::DataStreamError, u"Canvas ended before payload."_s);
 
     return ArtworkError();
 }
@@ -36,7 +36,7 @@ private:
 //-Constructor---------------------------------------------------------------------------------------------------------
 public:
     MultiPartWork();
-    MultiPartWork(const QByteArray& tag, const QByteArray& partPayload, checksum_t completeChecksum, part_idx_t partIdx, part_idx_t partCount);
+    MultiPartWork(const QByteArray& tag, const QByteArray& partPayload, checksum_t partChecksum, checksum_t completeChecksum, part_idx_t partIdx, part_idx_t partCount);
 
 //-Class Functions----------------------------------------------------------------------------------------------
 private:
@@ -45,8 +45,8 @@ private:
 //-Instance Functions----------------------------------------------------------------------------------------------
 private:
     quint64 renditionSize() const override;
-    ArtworkError renditionRead(QDataStream& stream) override;
-    ArtworkError renditionWrite(QDataStream& stream) const override;
+    ArtworkError renditionRead(QDataStream& stream, Canvas& canvas) override;
+    ArtworkError renditionWrite(QDataStream& stream, Canvas& canvas) const override;
 
 public:
     QByteArray tag() const;
@@ -1,11 +1,16 @@
 // Unit Include
 #include "standard.h"
 
+// Standard Library Includes
+#include <algorithm>
+#include <array>
+
 // Qt Includes
 #include <QDataStream>
+#include <QtEndian>
 
-// Qx Includes
-#include <qx/core/qx-integrity.h>
+// Project Includes
+#include "integrity/crc32.h"
 
 namespace PxCryptPrivate
 {
@@ -17,13 +22,22 @@ namespace PxCryptPrivate
 //-Constructor---------------------------------------------------------------------------------------------------------
 //Protected:
 StandardWork::StandardWork() :
-    mChecksum(0)
+    mChecksum(0),
+    mPayloadSize(0),
+    mPayloadDevice(nullptr)
+{}
+
+StandardWork::StandardWork(QIODevice& payloadSink) :
+    mChecksum(0),
+    mPayloadSize(0),
+    mPayloadDevice(&payloadSink)
 {}
 
-StandardWork::StandardWork(const QByteArray& tag, const QByteArray& payload) :
+StandardWork::StandardWork(const QByteArray& tag, QIODevice& payloadSource, payload_length_t payloadSize) :
     mTag(tag),
-    mChecksum(Qx::Integrity::crc32(payload)),
-    mPayload(payload)
+    mChecksum(0), // Not known until the payload has been streamed
+    mPayloadSize(payloadSize),
+    mPayloadDevice(&payloadSource)
 {
     if(mTag.size() > std::numeric_limits<tag_length_t>::max())
         mTag.resize(std::numeric_limits<tag_length_t>::max());
@@ -42,34 +56,97 @@ quint64 StandardWork::renditionSize(tag_length_t tagSize, payload_length_t paylo
 
 //-Instance Functions----------------------------------------------------------------------------------------------
 //Private:
-quint64 StandardWork::renditionSize() const { return renditionSize(mTag.size(), mPayload.size()); }
+quint64 StandardWork::renditionSize() const { return renditionSize(mTag.size(), mPayloadSize); }
 
-ArtworkError StandardWork::renditionRead(QDataStream& stream)
+ArtworkError StandardWork::renditionRead(QDataStream& stream, Canvas& canvas)
 {
     tag_length_t tl; stream >> tl;
     mTag.resize(tl);
     stream.readRawData(mTag.data(), tl);
 
     stream >> mChecksum;
+    stream >> mPayloadSize;
+
+    // Don't trust the length blindly, it can't be more than what's left
+    if(qint64 avail = canvas.bytesAvailable(); mPayloadSize > avail)
+        return ArtworkError(ArtworkError::IntegrityError, u"The payload's length (%1) exceeds the space remaining (%2)."_s.arg(mPayloadSize).arg(avail));
+
+    checksum_t sumCheck;
+    if(mPayloadDevice)
+    {
+        // Pass along a chunk at a time
+        Crc32 crc;
+        QByteArray chunk(std::min<qint64>(mPayloadSize, STREAM_CHUNK_SIZE), Qt::Uninitialized);
+        qint64 remaining = mPayloadSize;
+        while(remaining > 0)
+        {
+            qint64 len = std::min<qint64>(remaining, chunk.size());
+            if(canvas.skim(std::as_writable_bytes(std::span(chunk.data(), len))) != len)
+                return ArtworkError(ArtworkError::DataStreamError, u"Canvas ended before payload."_s);
+
+            QByteArrayView data(chunk.constData(), len);
+            crc.update(data);
+            if(mPayloadDevice->write(data.data(), len) != len)
+                return ArtworkError(ArtworkError::PayloadDeviceError, mPayloadDevice->errorString());
+
+            remaining -= len;
+        }
+
+        sumCheck = crc.value();
+    }
+    else
+    {
+        mPayload.resize(mPayloadSize);
+        if(canvas.skim(std::as_writable_bytes(std::span(mPayload.data(), mPayload.size()))) != mPayload.size())
+            return ArtworkError(ArtworkError::DataStreamError, u"Canvas ended before payload."_s);
+        sumCheck = Crc32::compute(mPayload);
+    }
 
-    payload_length_t pl; stream >> pl;
-    mPayload.resize(pl);
-    stream.readRawData(mPayload.data(), pl);
-
-    checksum_t sumCheck = Qx::Integrity::crc32(mPayload);
     if(mChecksum != sumCheck)
         return ArtworkError(ArtworkError::IntegrityError, u"The payload's checksum did not match its record."_s);
 
     return ArtworkError();
 }
 
-ArtworkError StandardWork::renditionWrite(QDataStream& stream) const
+ArtworkError StandardWork::renditionWrite(QDataStream& stream, Canvas& canvas) const
 {
+    Q_ASSERT(mPayloadDevice);
+
     stream << static_cast<tag_length_t>(mTag.size());
     stream.writeRawData(mTag.constData(), mTag.size());
-    stream << mChecksum
-           << static_cast<payload_length_t>(mPayload.size());
-    stream.writeRawData(mPayload.constData(), mPayload.size());
+
+    // The checksum precedes the payload but the payload is only ever seen a chunk at a time, so fill it in after
+    qint64 checksumPos = canvas.reserve(sizeof(checksum_t));
+    if(checksumPos < 0)
+        return ArtworkError(ArtworkError::DataStreamError, u"Canvas ended before checksum."_s);
+    stream << mPayloadSize;
+
+    Crc32 crc;
+    QByteArray chunk(std::min<qint64>(mPayloadSize, STREAM_CHUNK_SIZE), Qt::Uninitialized);
+    qint64 remaining = mPayloadSize;
+    while(remaining > 0)
+    {
+        qint64 read = mPayloadDevice->read(chunk.data(), std::min<qint64>(remaining, chunk.size()));
+        if(read == 0 && mPayloadDevice->waitForReadyRead(-1))
+            continue; // Sequential source that just isn't ready yet
+        if(read <= 0)
+        {
+            QString reason = read < 0 ? mPayloadDevice->errorString() : u"Ended %1 bytes early."_s.arg(remaining);
+            return ArtworkError(ArtworkError::PayloadDeviceError, reason);
+        }
+
+        QByteArrayView data(chunk.constData(), read);
+        crc.update(data);
+        if(canvas.weave(std::as_bytes(std::span(data.data(), read))) != read)
+            return ArtworkError(ArtworkError::DataStreamError, u"Canvas ended before payload."_s);
+
+        remaining -= read;
+    }
+
+    std::array<char, sizeof(checksum_t)> sumBytes;
+    qToBigEndian(crc.value(), sumBytes.data()); // QDataStream's default byte order
+    if(!canvas.fill(checksumPos, QByteArrayView(sumBytes.data(), sumBytes.size())))
+        return ArtworkError(ArtworkError::DataStreamError, u"Failed to record checksum."_s);
 
     return ArtworkError();
 }
@@ -78,6 +155,7 @@ ArtworkError StandardWork::renditionWrite(QDataStream& stream) const
 StandardWork::checksum_t StandardWork::checksum() const { return mChecksum; }
 QByteArray StandardWork::tag() const { return mTag; }
 QByteArray StandardWork::payload() const { return mPayload; }
+StandardWork::payload_length_t StandardWork::payloadSize() const { return mPayloadSize; }
 
 
 //===============================================================================================================
@@ -23,16 +23,23 @@ public:
     using tag_length_t = quint16;
     using payload_length_t = quint32;
 
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    static constexpr qint64 STREAM_CHUNK_SIZE = 1024 * 1024; // Payload is moved between device and canvas this much at a time
+
 //-Instance Variables------------------------------------------------------------------------------------------------------
 private:
     QByteArray mTag;
     checksum_t mChecksum;
     QByteArray mPayload;
+    payload_length_t mPayloadSize;
+    QIODevice* mPayloadDevice; // Source when writing, optional sink when reading (in place of mPayload)
 
 //-Constructor---------------------------------------------------------------------------------------------------------
 public:
     StandardWork();
-    StandardWork(const QByteArray& tag, const QByteArray& payload);
+    StandardWork(QIODevice& payloadSink);
+    StandardWork(const QByteArray& tag, QIODevice& payloadSource, payload_length_t payloadSize);
 
 //-Class Functions----------------------------------------------------------------------------------------------
 private:
@@ -41,13 +48,14 @@ private:
 //-Instance Functions----------------------------------------------------------------------------------------------
 private:
     quint64 renditionSize() const override;
-    ArtworkError renditionRead(QDataStream& stream) override;
-    ArtworkError renditionWrite(QDataStream& stream) const override;
+    ArtworkError renditionRead(QDataStream& stream, Canvas& canvas) override;
+    ArtworkError renditionWrite(QDataStream& stream, Canvas& canvas) const override;
 
 public:
     checksum_t checksum() const;
     QByteArray tag() const;
     QByteArray payload() const;
+    payload_length_t payloadSize() const;
 };
 
 class StandardWork::Measure : public IMeasure
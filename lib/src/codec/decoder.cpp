@@ -14,7 +14,9 @@ namespace PxCrypt
 //-Constructor---------------------------------------------------------------------------------------------------
 //Protected:
 DecoderPrivate::DecoderPrivate() :
-    mPsk()
+    mPsk(),
+    mThreads(1),
+    mReadOrder(Decoder::TraversalOrder)
 {}
 
 //-Destructor---------------------------------------------------------------------------------------------------
@@ -34,6 +36,24 @@ DecoderPrivate::~DecoderPrivate() {};
  *  skim and decrypt data from the color channels of an encoded image.
  */
 
+//-Class Enums-----------------------------------------------------------------------------------------------------
+/*!
+ *  @enum Decoder::ReadOrder
+ *
+ *  This enum specifies the order in which a decoder reads the pixels of an encoded image. Both orders
+ *  produce identical results; they only differ in how they access memory.
+ *
+ *  @var Decoder::ReadOrder Decoder::TraversalOrder
+ *  Pixels are read in the order they were encoded, with the skimmed data being written out sequentially.
+ *  This is the default.
+ *
+ *  @var Decoder::ReadOrder Decoder::MemoryOrder
+ *  The encoding order is resolved ahead of time and pixels are then read in the order they are laid out
+ *  in memory, with the skimmed data being scattered to its place in the payload instead. This moves the
+ *  random access from the image to the much smaller payload, which is usually faster for large images
+ *  at the cost of some additional memory while decoding.
+ */
+
 //-Constructor---------------------------------------------------------------------------------------------------
 //Protected:
 /*! @cond */
@@ -57,6 +77,20 @@ Decoder::~Decoder() {}
  */
 QByteArray Decoder::presharedKey() const { Q_D(const Decoder); return d->mPsk; }
 
+/*!
+ *  Returns the number of threads the decoder is configured to use when skimming data from a single image.
+ *
+ *  @sa setThreadCount().
+ */
+int Decoder::threadCount() const { Q_D(const Decoder); return d->mThreads; }
+
+/*!
+ *  Returns the order in which the decoder reads the pixels of an image.
+ *
+ *  @sa setReadOrder().
+ */
+Decoder::ReadOrder Decoder::readOrder() const { Q_D(const Decoder); return d->mReadOrder; }
+
 /*!
  *  Sets key used for scrambling the encoding sequence to @a key.
  *
@@ -67,4 +101,24 @@ QByteArray Decoder::presharedKey() const { Q_D(const Decoder); return d->mPsk; }
  */
 void Decoder::setPresharedKey(const QByteArray& key) { Q_D(Decoder); d->mPsk = key;}
 
+/*!
+ *  Sets the number of threads used to skim data from a single image to @a threads. A value of @c 0 or less
+ *  uses QThread::idealThreadCount().
+ *
+ *  Like Encoder::setThreadCount(), this only affects large payloads and does not change the result. The
+ *  default is @c 1 (sequential).
+ *
+ *  @sa threadCount().
+ */
+void Decoder::setThreadCount(int threads) { Q_D(Decoder); d->mThreads = threads; }
+
+/*!
+ *  Sets the order in which the decoder reads the pixels of an image to @a order.
+ *
+ *  This does not change the result, only how quickly it is produced. The default is TraversalOrder.
+ *
+ *  @sa readOrder().
+ */
+void Decoder::setReadOrder(ReadOrder order) { Q_D(Decoder); d->mReadOrder = order; }
+
 }
@@ -4,6 +4,9 @@
 // Qt Includes
 #include <QByteArray>
 
+// Project Includes
+#include "pxcrypt/codec/decoder.h"
+
 namespace PxCrypt
 {
 /*! @cond */
@@ -13,6 +16,8 @@ class DecoderPrivate
 //-Instance Variables----------------------------------------------------------------------------------------------
 public:
     QByteArray mPsk;
+    int mThreads;
+    Decoder::ReadOrder mReadOrder;
 
 //-Constructor---------------------------------------------------------------------------------------------------
 protected:
@@ -1,40 +1,60 @@
 // Unit Includes
 #include "encdec.h"
 
+// Standard Library Includes
+#include <cstring>
+
 // Qt Includes
 #include <QSize>
 
 // Qx Includes
 #include <qx/core/qx-algorithm.h>
 
+// Project Includes
+#include "medium_io/operate/px_grid.h"
+
 namespace PxCryptPrivate
 {
 
 //-Namespace Functions-------------------------------------------------------------------------------------------------
 QImage standardizeImage(const QImage& img)
 {
-    /* This isn't made entirely clear by the QImage/QColor documentation, but in order to correctly manipulate
-     * an image's pixles via QImage::bits() and QRgb (as shown in the QImage example), the image must be in a format
-     * in which the pixels are 32-bits wide, ordered as AARRGGBB. The QRgb documentation makes it clear that this is the
-     * QRgb layout, but then elsewhere makes it sound like you can use these values with qRed(), qGreen(), regardless of format
-     * when accessing pixel data directly; however, although the red(), green(), blue() and alpha() helpers are byte-order
-     * agnostic, they are not format agnostic. You can only read/assign QRgb values in a format agnostic manner by using
-     * QImage::pixel() and QImage::setPixel(), but those both have much more overhead as stated in the QImage docs.
+    /* This isn't made entirely clear by the QImage/QColor documentation, but although the qRed(), qGreen(), etc. helpers
+     * are byte-order agnostic, they are not format agnostic; QRgb values can only be read/assigned in a format agnostic
+     * manner by using QImage::pixel() and QImage::setPixel(), both of which have much more overhead than direct access as
+     * stated in the QImage docs.
      *
-     * Because of this, all images are standardized to the ARGB layout to ensure the correct channels are accessed during
-     * encoding/decoding. This of course introduces some performance loss due to the potential need to convert the whole image,
-     * but it's less than the overhead of using QImage::pixel()/QImage::setPixel() on every pixel. It is possible to check the
-     * input format and read color channels in reverse if the format uses BGRA, but this would only cover a small few formats
-     * and conversion for standardization needs to occur for non 32-bit, specifically 8-bits per channel, formats anyway so mind
-     * as well handle channel ordering standardization through conversion as well.
+     * Because of this, pixels are accessed directly through a layout that knows where each channel of a given format lives
+     * (see PxGrid), which covers the common 8-bits per channel formats (ARGB32, RGB32, RGBA8888, RGBX8888, RGB888 and BGR888).
+     * Everything else (palettes, 16-bit, premultiplied, etc.) is converted to ARGB32 or RGB32, which of course costs a pass
+     * over the whole image, but is still cheaper than using QImage::pixel()/QImage::setPixel() on every pixel.
+     *
+     * Images with padding at the end of each scan line are repacked as well, so that pixels can always be addressed
+     * by their index alone. Qt never pads the lines of 4 byte formats itself, so those are only padded when wrapping
+     * a caller's buffer and a plain copy is enough; 3 byte formats are padded whenever a line isn't a multiple of 4
+     * bytes long, and are converted to RGB32 instead.
      */
 
     QImage std = img; // Because of Qt's CoW system this occurs almost no penalty if the format is already acceptable
-    QImage::Format fmt = std.format();
-    if(fmt != QImage::Format_ARGB32 && fmt != QImage::Format_RGB32)
+    if(std.isNull())
+        return std;
+
+    if(!PxGrid::supports(std.format()))
         std.convertTo(std.hasAlphaChannel() ? QImage::Format_ARGB32 : QImage::Format_RGB32);
+    else if(!PxGrid::isPacked(std))
+        std = std.depth() == 32 ? std.copy() : std.convertedTo(QImage::Format_RGB32);
 
     return std;
 }
 
+void copyPixels(QImage& dst, const QImage& src)
+{
+    // Converts to the destination's format as needed, and leaves any padding at the end of its scan lines alone
+    Q_ASSERT(dst.size() == src.size());
+    QImage converted = src.convertedTo(dst.format());
+    qsizetype lineBytes = (static_cast<qsizetype>(dst.width()) * dst.depth()) / 8;
+    for(int y = 0; y < dst.height(); ++y)
+        std::memcpy(dst.scanLine(y), converted.constScanLine(y), lineBytes);
+}
+
 }
@@ -29,7 +29,10 @@ constexpr quint8 BPC_MIN = 1; // TODO: Can clamp to do away with these
 constexpr quint8 BPC_MAX = 7;
 
 //-Namespace Functions-------------------------------------------------------------------------------------------------
+constexpr int channelShift(Channel ch) { return (3 - ch) * 8; } // Bit offset of a channel within a QRgb (0xAARRGGBB)
+constexpr quint8 channelValue(QRgb px, Channel ch) { return static_cast<quint8>(px >> channelShift(ch)); }
 QImage standardizeImage(const QImage& img); //TODO: See if this can go somewhere else
+void copyPixels(QImage& dst, const QImage& src);
 
 }
 
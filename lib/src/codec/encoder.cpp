@@ -25,7 +25,9 @@ namespace PxCrypt
 EncoderPrivate::EncoderPrivate() :
     mBpc(1),
     mEncoding(Encoder::Absolute),
-    mPsk()
+    mRevision(Encoder::Original),
+    mPsk(),
+    mThreads(1)
 {}
 
 //-Destructor---------------------------------------------------------------------------------------------------
@@ -107,6 +109,41 @@ EncoderPrivate::~EncoderPrivate() {};
  *  Does not require the original medium(s) in order to decode the encrypted data.
  */
 
+/*!
+ *  @enum Encoder::Revision
+ *
+ *  This enum specifies the revision of the image format used when encoding, which determines the order in
+ *  which the pixels and channels of a medium are visited. Revisions do not affect the amount of distortion, only
+ *  how expensive an image is to traverse, with later revisions being cheaper.
+ *
+ *  The revision is recorded in an image's metadata so decoders always handle it automatically. Images
+ *  using any revision other than Original take up one additional meta pixel and cannot be decoded by
+ *  versions of PxCrypt that predate that revision.
+ *
+ *  @var Encoder::Revision Encoder::Original
+ *  The format used by every release before revisions were introduced. This is the default revision.
+ *
+ *  @var Encoder::Revision Encoder::ChannelTable
+ *  The channel order of each pixel is chosen with a single random draw from a table of all orders, instead of
+ *  drawing each channel individually.
+ *
+ *  @var Encoder::Revision Encoder::FastRng
+ *  Like ChannelTable, but the pixel order is drawn from a xoshiro256** generator instead of a Mersenne Twister,
+ *  and the channel order of each pixel is derived directly from its position in the sequence.
+ *
+ *  @var Encoder::Revision Encoder::Permutation
+ *  Like FastRng, but the pixel order is a keyed permutation of all pixels that can be computed for any position
+ *  directly, instead of being drawn one pixel at a time. This requires no memory to track visited pixels and
+ *  costs the same regardless of how full the image is, which makes it best suited to very large mediums.
+ *
+ *  @var Encoder::Revision Encoder::BlockShuffle
+ *  Like Permutation, but the keyed permutation places blocks of 256 contiguous pixels instead of individual
+ *  pixels, with the pixels within each block visited in a cheaply shuffled order. Data is still spread across
+ *  the whole image, but each block is read or written in one go, which is far friendlier to the cache. When
+ *  the image is only partly filled, the altered pixels form runs along rows instead of being scattered
+ *  individually, though the amount of distortion is the same.
+ */
+
 //-Constructor---------------------------------------------------------------------------------------------------
 //Protected:
 /*! @cond */
@@ -137,6 +174,13 @@ quint8 Encoder::bpc() const { Q_D(const Encoder); return d->mBpc; }
  */
 Encoder::Encoding Encoder::encoding() const { Q_D(const Encoder); return d->mEncoding; }
 
+/*!
+ *  Returns the format revision the encoder is configured to use.
+ *
+ *  @sa setRevision().
+ */
+Encoder::Revision Encoder::revision() const { Q_D(const Encoder); return d->mRevision; }
+
 /*!
  *  Returns the key the encoder is configured to use for data scrambling.
  *
@@ -144,6 +188,13 @@ Encoder::Encoding Encoder::encoding() const { Q_D(const Encoder); return d->mEnc
  */
 QByteArray Encoder::presharedKey() const { Q_D(const Encoder); return d->mPsk; }
 
+/*!
+ *  Returns the number of threads the encoder is configured to use when weaving data into a single image.
+ *
+ *  @sa setThreadCount().
+ */
+int Encoder::threadCount() const { Q_D(const Encoder); return d->mThreads; }
+
 /*!
  *  Sets the number of bits-per-channel the encoder is configured to use to @a bpc.
  *
@@ -161,6 +212,13 @@ void Encoder::setBpc(quint8 bpc) { Q_D(Encoder); d->mBpc = bpc; }
  */
 void Encoder::setEncoding(Encoding enc) { Q_D(Encoder); d->mEncoding = enc; }
 
+/*!
+ *  Sets the format revision to use to @a rev.
+ *
+ *  @sa revision() and Revision.
+ */
+void Encoder::setRevision(Revision rev) { Q_D(Encoder); d->mRevision = rev; }
+
 /*!
  *  Sets key used for scrambling the encoding sequence to @a key.
  *
@@ -171,4 +229,16 @@ void Encoder::setEncoding(Encoding enc) { Q_D(Encoder); d->mEncoding = enc; }
  */
 void Encoder::setPresharedKey(const QByteArray& key) { Q_D(Encoder); d->mPsk = key;}
 
+/*!
+ *  Sets the number of threads used to weave data into a single image to @a threads. A value of @c 0 or less
+ *  uses QThread::idealThreadCount().
+ *
+ *  Large payloads are split into runs that are woven concurrently, which produces exactly the same image as
+ *  weaving sequentially. Only spans of at least several tens of kilobytes per thread are split, so this has no
+ *  effect on small payloads. The default is @c 1 (sequential).
+ *
+ *  @sa threadCount().
+ */
+void Encoder::setThreadCount(int threads) { Q_D(Encoder); d->mThreads = threads; }
+
 }
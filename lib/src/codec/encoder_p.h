@@ -17,7 +17,9 @@ class EncoderPrivate
 public:
     quint8 mBpc;
     Encoder::Encoding mEncoding;
+    Encoder::Revision mRevision;
     QByteArray mPsk;
+    int mThreads;
 
 //-Constructor---------------------------------------------------------------------------------------------------
 protected:
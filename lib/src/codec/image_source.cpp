@@ -0,0 +1,226 @@
+// Unit Includes
+#include "pxcrypt/codec/image_source.h"
+
+// Qt Includes
+#include <QIODevice>
+#include <QImageReader>
+
+namespace PxCrypt
+{
+/*! @cond */
+
+//===============================================================================================================
+// ImageSourcePrivate
+//===============================================================================================================
+
+class ImageSourcePrivate
+{
+//-Instance Variables----------------------------------------------------------------------------------------------
+public:
+    QImage mImage;
+    QString mPath;
+    QIODevice* mDevice;
+    qint64 mDeviceStart;
+
+//-Constructor---------------------------------------------------------------------------------------------------
+public:
+    ImageSourcePrivate();
+
+//-Instance Functions---------------------------------------------------------------------------------------------
+public:
+    template<typename F>
+    auto withReader(F f) const;
+};
+
+//-Constructor---------------------------------------------------------------------------------------------------
+//Public:
+ImageSourcePrivate::ImageSourcePrivate() :
+    mImage(),
+    mPath(),
+    mDevice(nullptr),
+    mDeviceStart(0)
+{}
+
+//-Instance Functions---------------------------------------------------------------------------------------------
+//Public:
+template<typename F>
+auto ImageSourcePrivate::withReader(F f) const
+{
+    /* A fresh reader is used every time since a source is touched once to measure it and again, possibly
+     * on another thread, to load it. Devices are rewound to where they were when the source was created
+     * so that both passes see the image from its start.
+     */
+    if(mDevice)
+    {
+        mDevice->seek(mDeviceStart);
+        QImageReader reader(mDevice);
+        return f(reader);
+    }
+
+    QImageReader reader(mPath);
+    return f(reader);
+}
+
+/*! @endcond */
+
+//===============================================================================================================
+// ImageSource
+//===============================================================================================================
+
+/*!
+ *  @class ImageSource <pxcrypt/codec/image_source.h>
+ *
+ *  @brief The ImageSource class provides an image to an encoder or decoder either directly or from storage,
+ *  in which case it is only loaded once it's needed.
+ *
+ *  Sources backed by a file or device are measured using only the image's header where the format allows,
+ *  and their pixels are decoded just before the image is processed and released right after. This allows
+ *  codecs that work with many images, like MultiEncoder and MultiDecoder, to keep only as many images in
+ *  memory as are being worked on at once.
+ *
+ *  @sa MultiEncoder::encode() and MultiDecoder::decode().
+ */
+
+//-Constructor---------------------------------------------------------------------------------------------------
+//Public:
+/*!
+ *  Constructs a source for the already loaded @a image.
+ */
+ImageSource::ImageSource(const QImage& image) :
+    d_ptr(std::make_unique<ImageSourcePrivate>())
+{
+    Q_D(ImageSource);
+    d->mImage = image;
+}
+
+/*!
+ *  Constructs a source for the image file at @a filePath.
+ */
+ImageSource::ImageSource(const QString& filePath) :
+    d_ptr(std::make_unique<ImageSourcePrivate>())
+{
+    Q_D(ImageSource);
+    d->mPath = filePath;
+}
+
+/*!
+ *  Constructs a source for the image that starts at the current position of @a device.
+ *
+ *  @a device must already be open, must be random-access, and must outlive the source. Its position is
+ *  changed whenever the source is measured or loaded, and a device must not be shared between sources
+ *  that are used at the same time.
+ */
+ImageSource::ImageSource(QIODevice* device) :
+    d_ptr(std::make_unique<ImageSourcePrivate>())
+{
+    Q_D(ImageSource);
+    Q_ASSERT(device && !device->isSequential());
+    d->mDevice = device;
+    d->mDeviceStart = device->pos();
+}
+
+/*!
+ *  Constructs a copy of @a other.
+ */
+ImageSource::ImageSource(const ImageSource& other) :
+    d_ptr(std::make_unique<ImageSourcePrivate>(*other.d_ptr))
+{}
+
+/*!
+ *  Move-constructs a source from @a other.
+ *
+ *  @a other is left as a loaded source holding a null image.
+ */
+ImageSource::ImageSource(ImageSource&& other) noexcept :
+    d_ptr(std::make_unique<ImageSourcePrivate>())
+{
+    d_ptr.swap(other.d_ptr);
+}
+
+//-Destructor---------------------------------------------------------------------------------------------------
+//Public:
+/*!
+ *  Destroys the source.
+ */
+ImageSource::~ImageSource() {}
+
+//-Instance Functions-------------------------------------------------------------------------------------------
+//Public:
+/*!
+ *  Returns @c true if the source holds an already loaded image; otherwise, returns @c false.
+ */
+bool ImageSource::isLoaded() const { Q_D(const ImageSource); return !d->mDevice && d->mPath.isEmpty(); }
+
+/*!
+ *  Returns the dimensions of the source image, or an invalid size if they could not be determined, in
+ *  which case @a errorString is set to the reason if it isn't @c nullptr.
+ *
+ *  For sources that are not already loaded, the size is read from the image's header if the format
+ *  supports it; otherwise, the image has to be fully decoded.
+ */
+QSize ImageSource::size(QString* errorString) const
+{
+    Q_D(const ImageSource);
+    if(isLoaded())
+        return d->mImage.size();
+
+    return d->withReader([errorString](QImageReader& reader){
+        QSize size = reader.size();
+        if(!size.isValid())
+        {
+            // Not all formats can provide their size up front
+            QImage image;
+            if(reader.read(&image))
+                size = image.size();
+            else if(errorString)
+                *errorString = reader.errorString();
+        }
+        return size;
+    });
+}
+
+/*!
+ *  Returns the source image, loading it if necessary, or a null image if it could not be loaded, in which case
+ *  @a errorString is set to the reason if it isn't @c nullptr.
+ *
+ *  Images are not cached, so each call to this function loads the image again unless the source is already
+ *  loaded.
+ */
+QImage ImageSource::load(QString* errorString) const
+{
+    Q_D(const ImageSource);
+    if(isLoaded())
+        return d->mImage;
+
+    return d->withReader([errorString](QImageReader& reader){
+        QImage image;
+        if(!reader.read(&image) && errorString)
+            *errorString = reader.errorString();
+        return image;
+    });
+}
+
+//-Operators----------------------------------------------------------------------------------------------------------
+//Public:
+/*!
+ *  Assigns @a other to this source.
+ */
+ImageSource& ImageSource::operator=(const ImageSource& other)
+{
+    if(this != &other)
+        d_ptr = std::make_unique<ImageSourcePrivate>(*other.d_ptr);
+    return *this;
+}
+
+/*!
+ *  Move-assigns @a other to this source.
+ *
+ *  @a other is left holding what this source held before.
+ */
+ImageSource& ImageSource::operator=(ImageSource&& other) noexcept
+{
+    d_ptr.swap(other.d_ptr);
+    return *this;
+}
+
+}
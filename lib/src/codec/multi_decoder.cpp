@@ -3,17 +3,17 @@
 
 // Standard Library Includes
 #include <algorithm>
-#include <execution>
 
 // Qt Includes
+#include <QBuffer>
+#include <QTemporaryFile>
 #include <QtConcurrent>
 
-// Qx Includes
-#include <qx/core/qx-integrity.h>
-
 // Project Includes
 #include "codec/decoder_p.h"
 #include "art_io/works/multipart.h"
+#include "integrity/crc32.h"
+#include "medium_io/sequence/px_schedule_cache.h"
 #include "pxcrypt/stat.h"
 
 using namespace PxCryptPrivate;
@@ -37,6 +37,175 @@ public:
     Error error() const { return mError; }
 };
 
+//===============================================================================================================
+// PartAssembler
+//===============================================================================================================
+
+/* Writes decoded parts to the payload sink in part order as they come in from the workers, in whatever order
+ * that happens to be. A part that arrives before all of the ones ahead of it is parked until its turn, either
+ * in memory or in a temporary spill file, so that at most one part per worker needs to be in memory at a time
+ * when spilling. Each part's checksum was already verified while it was read, so the complete checksum is
+ * confirmed by combining those instead of going over the payload again.
+ */
+class PartAssembler
+{
+//-Structs-----------------------------------------------------------------------------------------------------
+private:
+    struct Slot
+    {
+        bool placed = false;
+        MultiPartWork::checksum_t checksum = 0;
+        qint64 length = 0;
+        qint64 spillOffset = -1;
+        QByteArray held;
+    };
+
+//-Class Variables---------------------------------------------------------------------------------------------
+private:
+    static constexpr qint64 SPILL_CHUNK = 64 * 1024;
+
+//-Instance Variables--------------------------------------------------------------------------------------------
+private:
+    QMutex mMutex;
+    QIODevice& mSink;
+    bool mSpill;
+    std::unique_ptr<QTemporaryFile> mSpillFile;
+    QList<Slot> mSlots;
+    qsizetype mNext;
+    bool mHaveReference;
+    QByteArray mTag;
+    MultiPartWork::checksum_t mCompleteChecksum;
+
+//-Constructor---------------------------------------------------------------------------------------------------
+public:
+    PartAssembler(QIODevice& sink, qsizetype partCount, bool spill);
+
+//-Instance Functions--------------------------------------------------------------------------------------------
+private:
+    bool park(Slot& slot, const QByteArray& data);
+    bool writeParked(Slot& slot);
+
+public:
+    Error place(qsizetype imageIdx, const MultiPartWork& work);
+    Error finish();
+    QByteArray tag() const;
+};
+
+//-Constructor---------------------------------------------------------------------------------------------------
+//Public:
+PartAssembler::PartAssembler(QIODevice& sink, qsizetype partCount, bool spill) :
+    mSink(sink),
+    mSpill(spill),
+    mSlots(partCount),
+    mNext(0),
+    mHaveReference(false),
+    mCompleteChecksum(0)
+{}
+
+//-Instance Functions--------------------------------------------------------------------------------------------
+//Private:
+bool PartAssembler::park(Slot& slot, const QByteArray& data)
+{
+    if(!mSpill)
+    {
+        slot.held = data;
+        return true;
+    }
+
+    if(!mSpillFile)
+    {
+        mSpillFile = std::make_unique<QTemporaryFile>();
+        if(!mSpillFile->open())
+            return false;
+    }
+
+    slot.spillOffset = mSpillFile->size();
+    return mSpillFile->seek(slot.spillOffset) && mSpillFile->write(data) == data.size();
+}
+
+bool PartAssembler::writeParked(Slot& slot)
+{
+    if(slot.spillOffset < 0)
+    {
+        bool written = mSink.write(slot.held) == slot.held.size();
+        slot.held = QByteArray();
+        return written;
+    }
+
+    if(!mSpillFile->seek(slot.spillOffset))
+        return false;
+
+    QByteArray chunk;
+    for(qint64 remaining = slot.length; remaining > 0; remaining -= chunk.size())
+    {
+        chunk = mSpillFile->read(std::min(remaining, SPILL_CHUNK));
+        if(chunk.isEmpty() || mSink.write(chunk) != chunk.size())
+            return false;
+    }
+
+    return true;
+}
+
+//Public:
+Error PartAssembler::place(qsizetype imageIdx, const MultiPartWork& work)
+{
+    QMutexLocker locker(&mMutex);
+
+    // Compare against the first part to arrive
+    if(!mHaveReference)
+    {
+        if(work.partCount() != mSlots.size())
+            return Error(Error::PartsMissing, -1, u"Have %1 parts, need %2."_s.arg(mSlots.size()).arg(work.partCount()));
+
+        mTag = work.tag();
+        mCompleteChecksum = work.completeChecksum();
+        mHaveReference = true;
+    }
+    else if(work.tag() != mTag)
+        return Error(Error::PartMismatch, imageIdx, u"The part tag was different than the rest."_s);
+    else if(work.completeChecksum() != mCompleteChecksum)
+        return Error(Error::PartMismatch, imageIdx, u"The complete checksum was different from the rest."_s);
+
+    qsizetype partIdx = work.partIdx();
+    if(partIdx >= mSlots.size() || mSlots[partIdx].placed)
+        return Error(Error::PartMismatch, imageIdx, u"The part index was unexpected (incomplete set with unrelated image)."_s);
+
+    Slot& slot = mSlots[partIdx];
+    slot.placed = true;
+    slot.checksum = work.partChecksum();
+    slot.length = work.partPayload().size();
+
+    // Park the part if it's early, otherwise write it along with any parked ones that directly follow
+    const Error writeErr(Error::SkimFailed, imageIdx, u"The payload could not be written to the sink."_s);
+    if(partIdx != mNext)
+        return park(slot, work.partPayload()) ? Error() : writeErr;
+
+    if(mSink.write(work.partPayload()) != slot.length)
+        return writeErr;
+
+    for(++mNext; mNext < mSlots.size() && mSlots[mNext].placed; ++mNext)
+        if(!writeParked(mSlots[mNext]))
+            return writeErr;
+
+    return Error();
+}
+
+Error PartAssembler::finish()
+{
+    Q_ASSERT(mNext == mSlots.size()); // Every image placed a unique part index below the part count
+
+    quint32 checksum = mSlots.front().checksum;
+    for(qsizetype i = 1; i < mSlots.size(); ++i)
+        checksum = Crc32::combine(checksum, mSlots[i].checksum, mSlots[i].length);
+
+    if(checksum != mCompleteChecksum)
+        return Error(Error::ChecksumMismatch, -1, u"The payload's checksum did not match its record."_s);
+
+    return Error();
+}
+
+QByteArray PartAssembler::tag() const { return mTag; }
+
 //===============================================================================================================
 // MultiDecoderPrivate
 //===============================================================================================================
@@ -57,7 +226,7 @@ public:
 
 //-Instance Functions--------------------------------------------------------------------------------------------
 public:
-    Error decode(QList<MultiPartWork>& decoded, const QList<QImage>& encoded, const QList<QImage>& mediums);
+    Error decode(QIODevice& decoded, bool spill, const QList<ImageSource>& encoded, const QList<ImageSource>& mediums);
 };
 
 //-Constructor---------------------------------------------------------------------------------------------------
@@ -83,32 +252,39 @@ MultiDecoder::Error MultiDecoderPrivate::fromArtworkError(const PxCryptPrivate::
 
 //-Instance Functions---------------------------------------------------------------------------------------------
 //Public:
-Error MultiDecoderPrivate::decode(QList<MultiPartWork>& decoded, const QList<QImage>& encoded, const QList<QImage>& mediums)
+Error MultiDecoderPrivate::decode(QIODevice& decoded, bool spill, const QList<ImageSource>& encoded, const QList<ImageSource>& mediums)
 {
+    /* Each worker loads its encoded image (and medium) only when it gets to it, and hands the part off to the
+     * assembler as soon as it's read, so neither the images nor the parts are all held at once.
+     */
+    PartAssembler assembler(decoded, encoded.size(), spill);
+    PxScheduleCache scheduleCache; // Parts are usually the same size, and so share a pixel schedule
+
     try{
-        decoded = QtConcurrent::blockingMapped(encoded, [&, listStart = &encoded[0]](const QImage& i){
+        QtConcurrent::blockingMap(encoded, [&, listStart = &encoded[0]](const ImageSource& src){
             /* We determine the original index by using the fact that QList stores
              * elements contiguously, in that we can take the difference between the
              * address of this image and the first.
              */
-            qsizetype origIdx = std::distance(listStart, &i);
+            qsizetype origIdx = std::distance(listStart, &src);
 
-            // Ensure encoded image is valid
-            if(i.isNull())
-                throw MultiDecoderException(Error(Error::InvalidSource, origIdx));
+            // Ensure encoded image is valid, normalize to standard pixel format
+            QString loadErr;
+            QImage iStd = standardizeImage(src.load(&loadErr));
+            if(iStd.isNull())
+                throw MultiDecoderException(Error(Error::InvalidSource, origIdx, loadErr));
 
             // Get image stats
-            Stat encStat(i);
+            Stat encStat(iStd);
 
             // Ensure image meets bare minimum space for meta pixels
             if(!encStat.fitsMetadata())
                 throw MultiDecoderException(Error(Error::NotLargeEnough, origIdx));
 
-            // Ensure standard pixel format
-            QImage iStd = standardizeImage(i);
-
             // Setup canvas
-            Canvas canvas(iStd, mPsk);
+            Canvas canvas(iStd, mPsk, &scheduleCache);
+            canvas.setThreadCount(mThreads);
+            canvas.setReadOrder(mReadOrder);
 
             // Ensure BPC is valid
             quint8 bpc = canvas.bpc();
@@ -120,8 +296,13 @@ Error MultiDecoderPrivate::decode(QList<MultiPartWork>& decoded, const QList<QIm
             if(!magic_enum::enum_contains(encoding))
                 throw MultiDecoderException(Error(Error::InvalidMeta, origIdx));
 
+            // Ensure revision is known
+            Encoder::Revision revision = canvas.revision();
+            if(!canvas.hasValidRevision() || !magic_enum::enum_contains(revision))
+                throw MultiDecoderException(Error(Error::InvalidMeta, origIdx));
+
             // Bare minimum size check
-            Stat::Capacity capacity = encStat.capacity(bpc);
+            Stat::Capacity capacity = encStat.capacity(bpc, revision);
             quint64 minSize = MultiPartWork::Measure().size();
             if(capacity.bytes < minSize)
                 throw MultiDecoderException(Error(Error::NotLargeEnough));
@@ -133,14 +314,13 @@ Error MultiDecoderPrivate::decode(QList<MultiPartWork>& decoded, const QList<QIm
                 if(mediums.size() != encoded.size())
                     throw MultiDecoderException(Error(Error::MissingMediums));
 
-                auto& med = mediums[origIdx];
-                if(med.isNull())
-                    throw MultiDecoderException(Error(Error::MissingMediums, origIdx));
+                mediumStd = standardizeImage(mediums[origIdx].load(&loadErr));
+                if(mediumStd.isNull())
+                    throw MultiDecoderException(Error(Error::MissingMediums, origIdx, loadErr));
 
-                if(med.size() != iStd.size())
+                if(mediumStd.size() != iStd.size())
                     throw MultiDecoderException(Error(Error::DimensionMismatch, origIdx));
 
-                mediumStd = standardizeImage(med);
                 canvas.setReference(&mediumStd);
             }
 
@@ -152,13 +332,19 @@ Error MultiDecoderPrivate::decode(QList<MultiPartWork>& decoded, const QList<QIm
             if(ArtworkError rErr = MultiPartWork::readFromCanvas(work, canvas))
                 throw MultiDecoderException(fromArtworkError(rErr, origIdx));
 
-            return work;
+            // Hand off
+            if(Error pErr = assembler.place(origIdx, work))
+                throw MultiDecoderException(pErr);
         });
     } catch (MultiDecoderException& e) {
         return e.error();
     }
 
-    return {};
+    if(Error fErr = assembler.finish())
+        return fErr;
+
+    mTag = assembler.tag(); // Only store tags from successfully decoded images
+    return Error();
 }
 
 /*! @endcond */
@@ -214,52 +400,50 @@ MultiDecoder::Error MultiDecoder::decode(QByteArray& decoded, const QList<QImage
     if(encoded.isEmpty())
         return Error(Error::MissingSources);
 
-    // Decode parts
-    QList<MultiPartWork> works;
-    if(auto err = d->decode(works, encoded, mediums))
-        return err;
+    QList<ImageSource> encSources(encoded.cbegin(), encoded.cend());
+    QList<ImageSource> medSources(mediums.cbegin(), mediums.cend());
 
-    // Grab some data arbitrarily from the first work to make comparisons
-    const auto& fw = works.front();
-    QString tag = fw.tag();
-    auto completeChecksum = fw.completeChecksum();
-    auto partCount = fw.partCount();
+    // Parts that arrive early are simply held in memory here since the whole payload will be anyway
+    QByteArray fullPayload;
+    QBuffer buffer(&fullPayload);
+    buffer.open(QIODevice::WriteOnly);
+    if(auto err = d->decode(buffer, false, encSources, medSources))
+        return err;
 
-    // Ensure enough parts are present
-    if(partCount != encoded.count())
-        return Error(Error::PartsMissing, -1, u"Have %1 parts, need %2."_s.arg(encoded.count(), partCount));
+    buffer.close();
+    decoded = fullPayload;
 
-    // Sort by part number
-    std::sort(std::execution::par, works.begin(), works.end(), [](const MultiPartWork& a, const MultiPartWork& b){
-        return a.partIdx() < b.partIdx();
-    });
+    return Error();
+}
 
-    // Build full payload and ensure correctness
-    QByteArray fullPayload;
-    for(qsizetype i = 0; i < works.size(); ++i)
-    {
-        auto& w = works.at(i);
-
-        // Ensure part is as expected
-        if(w.partIdx() != i)
-            return Error(Error::PartMismatch, i, u"The part index was unexpected (incomplete set with unrelated image)."_s);
-        else if(w.tag() != tag)
-            return Error(Error::PartMismatch, i, u"The part tag was different than the rest."_s);
-        else if(w.completeChecksum() != completeChecksum)
-            return Error(Error::PartMismatch, i, u"The complete checksum was different from the rest."_s);
-
-        // Add portion
-        fullPayload.append(w.partPayload());
-    }
+/*!
+ *  @overload
+ *
+ *  Retrieves data from the encoded set of PxCrypt images provided by @a encoded and writes the result to
+ *  @a decoded, which must already be open for writing, then returns an error status.
+ *
+ *  Images that are not already loaded are only loaded while they are being decoded, and each part of the
+ *  payload is written to @a decoded as soon as all of the parts before it have been, so at no point are all
+ *  of the images, or the whole payload, in memory. Parts that finish early are parked in a temporary file until
+ *  their turn comes. This makes this overload preferable for large image sets whose payload is headed for a file.
+ *
+ *  @a decoded is only ever written to sequentially, so it does not need to support seeking. The complete payload
+ *  checksum can only be confirmed once every part has been read, so @a decoded will already have been written to
+ *  if decoding fails; its contents should be discarded in that case.
+ *
+ *  @sa ImageSource.
+ */
+MultiDecoder::Error MultiDecoder::decode(QIODevice& decoded, const QList<ImageSource>& encoded, const QList<ImageSource>& mediums)
+{
+    Q_D(MultiDecoder);
 
-    // Check complete checksum
-    if(auto sumCheck = Qx::Integrity::crc32(fullPayload); sumCheck!= completeChecksum)
-        return Error(Error::ChecksumMismatch, -1, u"The payload's checksum did not match its record."_s);
+    if(encoded.isEmpty())
+        return Error(Error::MissingSources);
 
-    d->mTag = tag; // Only store tags from successfully decoded images
-    decoded = fullPayload;
+    if(!decoded.isWritable())
+        return Error(Error::SkimFailed, -1, u"The payload sink is not writable."_s);
 
-    return Error();
+    return d->decode(decoded, true, encoded, mediums);
 }
 
 //===============================================================================================================
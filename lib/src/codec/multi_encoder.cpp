@@ -4,16 +4,16 @@
 // Standard Library Includes
 #include <algorithm>
 #include <execution>
+#include <optional>
 
 // Qt Includes
 #include <QtConcurrent>
 
-// Qx Includes
-#include <qx/core/qx-integrity.h>
-
 // Project Includes
 #include "codec/encoder_p.h"
+#include "integrity/crc32.h"
 #include "art_io/works/multipart.h"
+#include "medium_io/sequence/px_schedule_cache.h"
 #include "pxcrypt/stat.h"
 #include "utility.h"
 
@@ -58,6 +58,7 @@ class MultiEncoderPrivate : public EncoderPrivate
 public:
     // Data
     QByteArray mTag;
+    int mImageConcurrency;
 
 //-Constructor---------------------------------------------------------------------------------------------------
 public:
@@ -104,17 +105,17 @@ public:
 //-Instance Functions---------------------------------------------------------------------------------------------
 public:
     // TODO: Simplify argument lists using a struct or temporarily storing the re-used args in this class
-    Error measureAndAccumulate(quint64& factorTotal, QList<Apportionment>& measurements, const QList<QImage>& mediums);
+    Error measureAndAccumulate(quint64& factorTotal, QList<Apportionment>& measurements, const QList<ImageSource>& mediums);
     quint64 initialApportionment(quint64 factorTotal, quint64 bytesTotal, QList<Apportionment>& apportionments);
     void finalApportionment(quint64 remainingBytes, QByteArrayView payload, QList<Apportionment>& apportionments);
-    Error encode(QByteArrayView payload, QList<QImage>& encoded, const QList<Apportionment>& finalApportionments, const QList<QImage>& mediums);
-    void restoreOriginalOrder(QList<QImage>& encoded, QList<Apportionment>& apportionments);
+    Error encode(QByteArrayView payload, const QList<Apportionment>& finalApportionments, const QList<ImageSource>& mediums, const MultiEncoder::EncodedSink& sink);
 };
 
 //-Constructor---------------------------------------------------------------------------------------------------
 //Public:
 MultiEncoderPrivate::MultiEncoderPrivate() :
-    mTag()
+    mTag(),
+    mImageConcurrency(0)
 {}
 
 //-Class Functions---------------------------------------------------------------------------------------------
@@ -134,7 +135,7 @@ Error MultiEncoderPrivate::fromArtworkError(const PxCryptPrivate::ArtworkError a
 
 //-Instance Functions---------------------------------------------------------------------------------------------
 //Public:
-Error MultiEncoderPrivate::measureAndAccumulate(quint64& factorTotal, QList<Apportionment>& measurements, const QList<QImage>& mediums)
+Error MultiEncoderPrivate::measureAndAccumulate(quint64& factorTotal, QList<Apportionment>& measurements, const QList<ImageSource>& mediums)
 {
     /* This is used to determine the proportionality of all input medium images. That is, which portion of
      * the input payload will be distributed to each image. We do this by seeing much "spare" space a medium
@@ -154,6 +155,9 @@ Error MultiEncoderPrivate::measureAndAccumulate(quint64& factorTotal, QList<Appo
      * function from QtConcurrent to calculate this, but that runs single-threaded at the end of the map function.
      * Instead, since we just need a simple integer sum, we can use an atomic variable that will be safely accessed
      * by any thread since the order in which it is accessed doesn't matter.
+     *
+     * Only the dimensions of each medium are needed here, which for sources that aren't loaded yet are read from
+     * their headers, so no pixel data is held at this stage.
      */
 
     // Setup
@@ -162,19 +166,21 @@ Error MultiEncoderPrivate::measureAndAccumulate(quint64& factorTotal, QList<Appo
     // Measure
     std::atomic<quint64> atomicTotal;
     try{
-        measurements = QtConcurrent::blockingMapped(mediums, [&, listStart = &mediums[0]](const QImage& i){
+        measurements = QtConcurrent::blockingMapped(mediums, [&, listStart = &mediums[0]](const ImageSource& i){
             /* We determine the original index by using the fact that QList stores
              * elements contiguously, in that we can take the difference between the
              * address of this image and the first.
              */
             qsizetype origIdx = std::distance(listStart, &i);
 
-            if(i.isNull())
-                throw MultiEncoderException(Error(Error::InvalidImage, origIdx));
+            QString sizeErr;
+            QSize size = i.size(&sizeErr);
+            if(size.isEmpty())
+                throw MultiEncoderException(Error(Error::InvalidImage, origIdx, sizeErr));
 
             // Create apportionment, 'payload' of 0 to check for maximum space, bpc of 1 as explained above
             Measure m(mTag.size(), 0);
-            auto factor = m.leftOverSpace(std::move(i.size()), 1);
+            auto factor = m.leftOverSpace(size, 1, mRevision);
             atomicTotal.fetch_add(factor, std::memory_order_relaxed); // Relaxed safe for a simple counter
 
             return Apportionment{
@@ -240,43 +246,76 @@ void MultiEncoderPrivate::finalApportionment(quint64 remainingBytes, QByteArrayV
     }
 }
 
-Error MultiEncoderPrivate::encode(QByteArrayView payload, QList<QImage>& encoded, const QList<Apportionment>& finalApportionments, const QList<QImage>& mediums)
+Error MultiEncoderPrivate::encode(QByteArrayView payload, const QList<Apportionment>& finalApportionments, const QList<ImageSource>& mediums, const MultiEncoder::EncodedSink& sink)
 {
     /* Here we use another atomic variable to track the offset from which the next payload slice should start. We can
      * use memory_order_relaxed here also because only the offset change needs to be atomic, but the order of everything
      * else is irrelevant.
      *
      * We also track the highest BPC used. They likely are all the same but a few might be different in edge cases.
+     *
+     * Each medium is loaded only once its worker gets to it and is handed to the sink as soon as it's encoded, so
+     * that no more than one image per worker is held at a time (unless the sources were already loaded).
      */
 
     std::atomic<Canvas::metavalue_t> bpcMax = 0;
-    auto fullChecksum = Qx::Integrity::crc32(payload);
+
+    /* Every part records its own checksum along with that of the whole payload, so rather than hashing the payload
+     * twice, the slices are hashed (in parallel) and the complete checksum is derived from theirs, in part order.
+     */
+    QList<MultiPartWork::checksum_t> partChecksums = QtConcurrent::blockingMapped(finalApportionments, [](const Apportionment& ap){
+        return Crc32::compute(ap.slice);
+    });
+
+    QList<const Apportionment*> inOrder(finalApportionments.size());
+    for(const Apportionment& ap : finalApportionments)
+        inOrder[ap.partIdx] = &ap;
+
+    MultiPartWork::checksum_t fullChecksum = 0; // Checksum of no data
+    for(const Apportionment* ap : std::as_const(inOrder))
+    {
+        qsizetype i = ap - finalApportionments.constData();
+        fullChecksum = Crc32::combine(fullChecksum, partChecksums[i], ap->slice.size());
+    }
+
+    /* Images are worked on by the global pool unless a limit is set, in which case they get a pool of their own
+     * so that the limit doesn't also apply to anything else sharing the global one, like the threads that weave
+     * within each image.
+     */
+    std::optional<QThreadPool> imagePool;
+    if(mImageConcurrency > 0)
+        imagePool.emplace().setMaxThreadCount(mImageConcurrency);
+
+    PxScheduleCache scheduleCache; // Parts are usually the same size, and so share a pixel schedule
 
     try{
-        encoded = QtConcurrent::blockingMapped(finalApportionments, [&](const Apportionment& ap){
-            // Get Image
+        QtConcurrent::blockingMap(imagePool ? &*imagePool : QThreadPool::globalInstance(), finalApportionments, [&](const Apportionment& ap){
+            // Load image, normalize to standard format
             auto idx = ap.origIdx;
-            auto& image = mediums.at(idx);
+            QString loadErr;
+            QImage workspace = standardizeImage(mediums.at(idx).load(&loadErr));
+            if(workspace.isNull())
+                throw MultiEncoderException(Error(Error::InvalidImage, idx, loadErr));
 
             // Measurements
-            Stat imageStat(image);
+            Stat imageStat(workspace);
             Measure measurement(mTag.size(), ap.bytes);
 
             // Determine BPC. Likely the same amount all images, but technically can be different
             auto bpc = mBpc;
             if(bpc == 0)// Calc BPC if auto
             {
-                bpc = measurement.minimumBpc(image.size());
+                bpc = measurement.minimumBpc(workspace.size(), mRevision);
                 if(bpc == 0)
                 {
                     // Check how short at max density (TODO: Make a central function for the size short string arg'ing since its reused so much)
-                    quint64 max = imageStat.capacity(BPC_MAX).bytes;
+                    quint64 max = imageStat.capacity(BPC_MAX, mRevision).bytes;
                     throw MultiEncoderException(Error(Error::WontFit, idx,  u"(%1 short)."_s.arg(Utility::dataStr(measurement.size() - max))));
                 }
             }
             else // Ensure data will fit with fixed BPC
             {
-                quint64 max = imageStat.capacity(bpc).bytes;
+                quint64 max = imageStat.capacity(bpc, mRevision).bytes;
                 if(measurement.size() > max)
                     throw MultiEncoderException(Error(Error::WontFit, idx,  u"(%1 short)."_s.arg(Utility::dataStr(measurement.size() - max))));
             }
@@ -284,24 +323,26 @@ Error MultiEncoderPrivate::encode(QByteArrayView payload, QList<QImage>& encoded
             // Track max BPC
             fetch_max(bpcMax, bpc);
 
-            // Copy base image, normalize to standard format
-            QImage workspace = standardizeImage(image);
-
             // Setup canvas, mark meta pixels, use self as reference if using relative encoding
-            Canvas canvas(workspace, mPsk);
+            Canvas canvas(workspace, mPsk, &scheduleCache);
+            canvas.setThreadCount(mThreads);
             canvas.setBpc(bpc);
             canvas.setEncoding(mEncoding);
+            canvas.setRevision(mRevision);
             canvas.setReference(mEncoding == Encoder::Relative ? &workspace : nullptr);
 
             // Prepare for IO
             canvas.open(QIODevice::WriteOnly); // Closes upon destruction
 
             // Write
-            MultiPartWork work(mTag, ap.slice.toByteArray(), fullChecksum, ap.partIdx, mediums.size());
+            qsizetype apIdx = &ap - finalApportionments.constData();
+            MultiPartWork work(mTag, ap.slice.toByteArray(), partChecksums[apIdx], fullChecksum, ap.partIdx, mediums.size());
             if(ArtworkError wErr = work.writeToCanvas(canvas))
                 throw MultiEncoderException(fromArtworkError(wErr, idx));
 
-            return workspace;
+            canvas.close();
+            if(!sink(idx, workspace))
+                throw MultiEncoderException(Error(Error::SinkFailed, idx));
         });
     } catch (MultiEncoderException& e) {
         return e.error();
@@ -311,36 +352,6 @@ Error MultiEncoderPrivate::encode(QByteArrayView payload, QList<QImage>& encoded
     return {};
 }
 
-void MultiEncoderPrivate::restoreOriginalOrder(QList<QImage>& encoded, QList<Apportionment>& apportionments)
-{
-    /* TODO: It would be nicer if we could avoid the initial sort, by perhaps creaing
-     * a vector beside apportionments with the bias value and a reference to the equivalent
-     * apportionments so that the apportionments list doesnt need to be sorted; though this
-     * would increase memory use while saving for time, and we actually are mainly worried
-     * about memory usage when N gets large
-     */
-
-    /* Uses cyclic permutations  sort to get back the original ordering. This mutates apportionments,
-     * with it ending up in the same order as encoded, but that's OK as we don't need it anymore after
-     * this function.
-     *
-     * https://stackoverflow.com/a/22183350/5667149
-     */
-
-    // Check all items
-    for(qsizetype i = 0; i < encoded.size() - 1; ++i)
-    {
-        // Cycle swap until the element is at its destination
-        auto dest = apportionments[i].origIdx;
-        while(i != dest)
-        {
-            encoded.swapItemsAt(i, dest);
-            apportionments.swapItemsAt(i, dest);
-            dest = apportionments[i].origIdx;
-        }
-    }
-}
-
 /*! @endcond */
 
 //===============================================================================================================
@@ -360,7 +371,9 @@ void MultiEncoderPrivate::restoreOriginalOrder(QList<QImage>& encoded, QList<App
  *  - BPC of 1
  *  - Empty pre-shared key
  *  - Absolute encoding
+ *  - Original format revision
  *  - Empty tag
+ *  - Images encoded concurrently on the global thread pool
  */
 MultiEncoder::MultiEncoder() : Encoder(std::make_unique<MultiEncoderPrivate>()) {}
 
@@ -368,18 +381,18 @@ MultiEncoder::MultiEncoder() : Encoder(std::make_unique<MultiEncoderPrivate>())
 //Public:
 /*!
  *  Returns the maximum number of payload bytes that can be stored within a images of dimensions @a dims and tag of size
- *  @a tagSize when using @a bpc bits per channel.
+ *  @a tagSize when using @a bpc bits per channel and format revision @a rev.
  *
  *  @sa calculateOptimalDensity().
  */
-quint64 MultiEncoder::calculateMaximumPayload(const QList<QSize>& dims, quint16 tagSize, quint8 bpc)
+quint64 MultiEncoder::calculateMaximumPayload(const QList<QSize>& dims, quint16 tagSize, quint8 bpc, Revision rev)
 {
     /* Could use an atomic counter here again, but since this function is less performance critical
      * and likely sees less use, we're going to experiment with QtConcurrent's reduce functions
      */
     auto calcOneCapacity = [&](const QSize& dim){
         MultiPartWork::Measure m(tagSize, 0); // 0 size payload to check for leftover
-        return m.leftOverSpace(dim, bpc);
+        return m.leftOverSpace(dim, bpc, rev);
     };
     auto sumReduce = [](quint64& sum, quint64 summand){
         sum += summand;
@@ -390,8 +403,8 @@ quint64 MultiEncoder::calculateMaximumPayload(const QList<QSize>& dims, quint16
 
 /*!
  *  Returns the minimum number of bits per channel required to store a payload of @a payloadSize along with a tag
- *  of @a tagSize within medium images of @a dims dimensions. @c 0 is returned if the payload/tag cannot fit within
- *  those dimensions.
+ *  of @a tagSize within medium images of @a dims dimensions using format revision @a rev. @c 0 is returned if the
+ *  payload/tag cannot fit within those dimensions.
  *
  *  Using the lowest BPC necessary is optimal as it will produce in the least distortion per pixel and the most
  *  even spread of the encoded data, overall resulting in the most minimal visual disturbance of the original image.
@@ -402,7 +415,7 @@ quint64 MultiEncoder::calculateMaximumPayload(const QList<QSize>& dims, quint16
  *
  *  @sa calculateMaximumStorage().
  */
-quint8 MultiEncoder::calculateOptimalDensity(const QList<QSize>& dims, quint16 tagSize, quint32 payloadSize)
+quint8 MultiEncoder::calculateOptimalDensity(const QList<QSize>& dims, quint16 tagSize, quint32 payloadSize, Revision rev)
 {
     // TODO: Could try this in parallel with C++26's fetch_min
     // Calculate a rough estimate using the smallest image (since it will suffer from header overhead the most)
@@ -424,7 +437,7 @@ quint8 MultiEncoder::calculateOptimalDensity(const QList<QSize>& dims, quint16 t
 
     quint32 estByteApportionment = std::round((double(smallestArea)/totalArea) * payloadSize);
     PxCryptPrivate::MultiPartWork::Measure m(tagSize, estByteApportionment);
-    return m.minimumBpc(smallestDim);
+    return m.minimumBpc(smallestDim, rev);
 }
 
 //-Instance Functions----------------------------------------------------------------------------------------------
@@ -436,6 +449,14 @@ quint8 MultiEncoder::calculateOptimalDensity(const QList<QSize>& dims, quint16 t
  */
 QString MultiEncoder::tag() const { Q_D(const MultiEncoder); return d->mTag; }
 
+/*!
+ *  Returns the maximum number of images the encoder is configured to load and encode at once, or @c 0 if that
+ *  is left up to the global thread pool.
+ *
+ *  @sa setImageConcurrency().
+ */
+int MultiEncoder::imageConcurrency() const { Q_D(const MultiEncoder); return d->mImageConcurrency; }
+
 /*!
  *  Sets the encoding tag to @a tag.
  *
@@ -450,10 +471,17 @@ QString MultiEncoder::tag() const { Q_D(const MultiEncoder); return d->mTag; }
 void MultiEncoder::setTag(const QByteArray& tag) { Q_D(MultiEncoder); d->mTag = tag; }
 
 /*!
- *  NOTE: Note how the order of the parts wont necessarily be the same as mediums
+ *  Limits the number of images that are loaded and encoded at once to @a images. A value of @c 0 or less
+ *  encodes images on QThreadPool::globalInstance(), as many at a time as it allows, which is the default.
  *
- *  @sa StandardDecoder::decode().
+ *  A limit is enforced with a thread pool dedicated to each encode() call, so it does not affect the global
+ *  pool or the threads used to weave within each image (see setThreadCount()). When using the overload that
+ *  takes a sink, this also bounds how many encoded images can be waiting to be handed off at a time.
+ *
+ *  @sa imageConcurrency().
  */
+void MultiEncoder::setImageConcurrency(int images) { Q_D(MultiEncoder); d->mImageConcurrency = images; }
+
 /*!
  *  Encodes @a payload within the medium image @a medium and stores the result in @a encoded, then
  *  returns an error status.
@@ -469,8 +497,12 @@ void MultiEncoder::setTag(const QByteArray& tag) { Q_D(MultiEncoder); d->mTag =
  *  edge cases where some might differ from the rest by +/- @c 1. The encoders BPC will be set to the highest
  *  BPC used in this case.
  *
- *  The encoded images will always use the format `QImage::Format_ARGB32` or `QImage::Format_RGB32`
- *  (depending on if the original has an alpha channel) regardless of the format of the original medium.
+ *  The encoded images keep the format of their original medium if it is one that can be accessed directly
+ *  (see StandardEncoder::encode()); otherwise, they will use the format `QImage::Format_ARGB32` or
+ *  `QImage::Format_RGB32` (depending on if the original has an alpha channel).
+ *
+ *  All mediums are held in memory for the duration of the encode, as are their encoded counterparts. For large
+ *  sets of mediums, prefer the overload that takes ImageSource objects and an EncodedSink.
  *
  *  @note The encoded images are always returned in the same order as the input mediums, though this order
  *  is not necessarlly the same as the order in which @a payload was split up. This is a non-issue however
@@ -493,6 +525,46 @@ void MultiEncoder::setTag(const QByteArray& tag) { Q_D(MultiEncoder); d->mTag =
  *  @sa StandardDecoder::decode().
  */
 Error MultiEncoder::encode(QList<QImage>& encoded, QByteArrayView payload, const QList<QImage>& mediums)
+{
+    // Clear return buffer
+    encoded.clear();
+
+    QList<ImageSource> sources;
+    sources.reserve(mediums.size());
+    for(const QImage& m : mediums)
+        sources.append(m);
+
+    // Each worker writes to its own slot, which keeps the original order without any sorting afterwards
+    QList<QImage> tempEncoded(mediums.size());
+    QImage* outputs = tempEncoded.data();
+    if(auto err = encode(payload, sources, [outputs](qsizetype index, const QImage& image){
+        outputs[index] = image;
+        return true;
+    }); err.isValid())
+        return err;
+
+    encoded = tempEncoded;
+    return Error();
+}
+
+/*!
+ *  @overload
+ *
+ *  Encodes @a payload within the images provided by @a mediums, passing each encoded image to @a sink, along with
+ *  the index of the medium it was produced from, as soon as it is complete, then returns an error status.
+ *
+ *  Mediums that are not already loaded are only measured up front, using just their headers where possible, and
+ *  are then loaded one by one as they are encoded. Combined with a sink that stores each image away (i.e. writes
+ *  it to disk), this keeps roughly as many images in memory at a time as there are images being encoded in
+ *  parallel, no matter how many mediums there are.
+ *
+ *  @a sink is called from worker threads, possibly concurrently and in no particular order, and so must be
+ *  thread-safe. If it returns @c false encoding is stopped and Error::SinkFailed is returned, though images
+ *  that were already passed to it are not recalled.
+ *
+ *  @sa ImageSource.
+ */
+Error MultiEncoder::encode(QByteArrayView payload, const QList<ImageSource>& mediums, const EncodedSink& sink)
 {
     /* NOTE: This doesn't use the PSK to generate new seeds for per-image PRNGs, which would be nice
      * for added scrambling, but currently impractical since we want to support loading the images
@@ -505,9 +577,6 @@ Error MultiEncoder::encode(QList<QImage>& encoded, QByteArrayView payload, const
      */
     Q_D(MultiEncoder);
 
-    // Clear return buffer
-    encoded.clear();
-
     // Ensure data was provided
     if(payload.isEmpty())
         return Error(Error::MissingPayload);
@@ -543,16 +612,7 @@ Error MultiEncoder::encode(QList<QImage>& encoded, QByteArrayView payload, const
     d->finalApportionment(remBytes, payload, apportionments);
 
     // Encode
-    QList<QImage> tempEncoded;
-    if(auto err = d->encode(payload, tempEncoded, apportionments, mediums); err.isValid())
-        return err;
-
-    // Reorder to original input order
-    d->restoreOriginalOrder(tempEncoded, apportionments);
-
-    encoded = tempEncoded;
-
-    return Error();
+    return d->encode(payload, apportionments, mediums, sink);
 }
 
 //===============================================================================================================
@@ -593,6 +653,9 @@ Error MultiEncoder::encode(QList<QImage>& encoded, QByteArrayView payload, const
  *
  *  @var MultiEncoder::Error::Type MultiEncoder::Error::WeaveFailed
  *  An unexpected error occurred while weaving data into a medium.
+ *
+ *  @var MultiEncoder::Error::Type MultiEncoder::Error::SinkFailed
+ *  The sink rejected an encoded image.
  */
 
 //-Constructor-------------------------------------------------------------
@@ -30,6 +30,10 @@ public:
 //-Class Functions---------------------------------------------------------------------------------------------
 public:
     static StandardDecoder::Error fromArtworkError(const PxCryptPrivate::ArtworkError& aError);
+
+//-Instance Functions---------------------------------------------------------------------------------------------
+public:
+    StandardDecoder::Error decode(PxCryptPrivate::StandardWork& work, const QImage& encoded, const QImage& medium);
 };
 
 //-Constructor---------------------------------------------------------------------------------------------------
@@ -53,6 +57,77 @@ StandardDecoder::Error StandardDecoderPrivate::fromArtworkError(const PxCryptPri
     return StandardDecoder::Error(StandardDecoder::Error::SkimFailed, spec);
 }
 
+StandardDecoder::Error StandardDecoderPrivate::decode(PxCryptPrivate::StandardWork& work, const QImage& encoded, const QImage& medium)
+{
+    using namespace PxCryptPrivate;
+
+    // Ensure encoded image is valid
+    if(encoded.isNull())
+        return StandardDecoder::Error(StandardDecoder::Error::InvalidSource);
+
+    // Get image stats
+    Stat encStat(encoded);
+
+    // Ensure image meets bare minimum space for meta pixels
+    if(!encStat.fitsMetadata())
+        return StandardDecoder::Error(StandardDecoder::Error::NotLargeEnough);
+
+    // Ensure standard pixel format
+    QImage encStd = standardizeImage(encoded);
+
+    // Setup canvas
+    Canvas canvas(encStd, mPsk);
+    canvas.setThreadCount(mThreads);
+    canvas.setReadOrder(mReadOrder);
+
+    // Ensure BPC is valid
+    quint8 bpc = canvas.bpc();
+    if(bpc < BPC_MIN || bpc > BPC_MAX)
+        return StandardDecoder::Error(StandardDecoder::Error::InvalidMeta);
+
+    // Ensure encoding is valid
+    Encoder::Encoding encoding = canvas.encoding();
+    if(!magic_enum::enum_contains(encoding))
+        return StandardDecoder::Error(StandardDecoder::Error::InvalidMeta);
+
+    // Ensure revision is known
+    Encoder::Revision revision = canvas.revision();
+    if(!canvas.hasValidRevision() || !magic_enum::enum_contains(revision))
+        return StandardDecoder::Error(StandardDecoder::Error::InvalidMeta);
+
+    // Bare minimum size check
+    Stat::Capacity capacity = encStat.capacity(bpc, revision);
+    quint64 minSize = StandardWork::Measure().size();
+    if(capacity.bytes < minSize)
+        return StandardDecoder::Error(StandardDecoder::Error::NotLargeEnough);
+
+    // Ensure medium image is valid if applicable
+    QImage mediumStd;
+    if(encoding == Encoder::Relative)
+    {
+        if(medium.isNull())
+            return StandardDecoder::Error(StandardDecoder::Error::MissingMedium);
+
+        if(medium.size() != encStd.size())
+            return StandardDecoder::Error(StandardDecoder::Error::DimensionMismatch);
+
+        mediumStd = standardizeImage(medium);
+        canvas.setReference(&mediumStd);
+    }
+
+    // Prepare for IO
+    canvas.open(QIODevice::ReadOnly); // Closes upon destruction
+
+    // Read
+    ArtworkError rErr = StandardWork::readFromCanvas(work, canvas);
+    if(rErr)
+        return fromArtworkError(rErr);
+
+    mTag = work.tag(); // Only store tags from successfully decoded images
+
+    return StandardDecoder::Error();
+}
+
 /*! @endcond */
 
 //===============================================================================================================
@@ -96,73 +171,42 @@ QString StandardDecoder::tag() const { Q_D(const StandardDecoder); return d->mTa
  */
 StandardDecoder::Error StandardDecoder::decode(QByteArray& decoded, const QImage& encoded, const QImage& medium)
 {
-    using namespace PxCryptPrivate;
-
     Q_D(StandardDecoder);
 
     // Clear return buffer
     decoded.clear();
 
-    // Ensure encoded image is valid
-    if(encoded.isNull())
-        return Error(Error::InvalidSource);
-
-    // Get image stats
-    Stat encStat(encoded);
-
-    // Ensure image meets bare minimum space for meta pixels
-    if(!encStat.fitsMetadata())
-        return Error(Error::NotLargeEnough);
-
-    // Ensure standard pixel format
-    QImage encStd = standardizeImage(encoded);
+    PxCryptPrivate::StandardWork work;
+    Error err = d->decode(work, encoded, medium);
+    if(!err)
+        decoded = work.payload();
 
-    // Setup canvas
-    Canvas canvas(encStd, d->mPsk);
-
-    // Ensure BPC is valid
-    quint8 bpc = canvas.bpc();
-    if(bpc < BPC_MIN || bpc > BPC_MAX)
-        return Error(Error::InvalidMeta);
-
-    // Ensure encoding is valid
-    Encoder::Encoding encoding = canvas.encoding();
-    if(!magic_enum::enum_contains(encoding))
-        return Error(Error::InvalidMeta);
-
-    // Bare minimum size check
-    Stat::Capacity capacity = encStat.capacity(bpc);
-    quint64 minSize = StandardWork::Measure().size();
-    if(capacity.bytes < minSize)
-        return Error(Error::NotLargeEnough);
-
-    // Ensure medium image is valid if applicable
-    QImage mediumStd;
-    if(encoding == Encoder::Relative)
-    {
-        if(medium.isNull())
-            return Error(Error::MissingMedium);
-
-        if(medium.size() != encStd.size())
-            return Error(Error::DimensionMismatch);
-
-        mediumStd = standardizeImage(medium);
-        canvas.setReference(&mediumStd);
-    }
-
-    // Prepare for IO
-    canvas.open(QIODevice::ReadOnly); // Closes upon destruction
+    return err;
+}
 
-    // Read
-    StandardWork work;
-    ArtworkError rErr = StandardWork::readFromCanvas(work, canvas);
-    if(rErr)
-        return d->fromArtworkError(rErr);
+/*!
+ *  @overload
+ *
+ *  Retrieves data from the encoded PxCrypt image @a encoded and writes the result to @a decoded, which must
+ *  already be open for writing, then returns an error status.
+ *
+ *  The payload is passed to the device a chunk at a time, with its checksum verified along the way, so the
+ *  memory required does not grow with the size of the payload. This makes this overload preferable for large
+ *  payloads that are headed for files.
+ *
+ *  Because the checksum can only be confirmed once the whole payload has been read, @a decoded will
+ *  already have been written to if decoding fails due to a checksum mismatch; its contents should be
+ *  discarded in that case.
+ */
+StandardDecoder::Error StandardDecoder::decode(QIODevice& decoded, const QImage& encoded, const QImage& medium)
+{
+    Q_D(StandardDecoder);
 
-    d->mTag = work.tag(); // Only store tags from successfully decoded images
-    decoded = work.payload();
+    if(!decoded.isWritable())
+        return Error(Error::SkimFailed, u"The payload sink is not writable."_s);
 
-    return Error();
+    PxCryptPrivate::StandardWork work(decoded);
+    return d->decode(work, encoded, medium);
 }
 
 //===============================================================================================================
@@ -1,11 +1,15 @@
 // Unit Includes
 #include "pxcrypt/codec/standard_encoder.h"
 
+// Qt Includes
+#include <QBuffer>
+
 // Project Includes
 #include "codec/encdec.h"
 #include "codec/encoder_p.h"
 #include "codec/encdec.h"
 #include "medium_io/canvas.h"
+#include "medium_io/operate/px_grid.h"
 #include "art_io/works/standard.h"
 #include "pxcrypt/stat.h"
 #include "utility.h"
@@ -32,6 +36,11 @@ public:
 //-Class Functions---------------------------------------------------------------------------------------------
 public:
     static StandardEncoder::Error fromArtworkError(const PxCryptPrivate::ArtworkError aError);
+
+//-Instance Functions---------------------------------------------------------------------------------------------
+public:
+    StandardEncoder::Error validate(const QImage& medium, const QIODevice& payloadSource, qint64 size);
+    StandardEncoder::Error weave(QImage& image, QIODevice& payloadSource, qint64 size);
 };
 
 //-Constructor---------------------------------------------------------------------------------------------------
@@ -55,6 +64,76 @@ StandardEncoder::Error StandardEncoderPrivate::fromArtworkError(const PxCryptPri
     return StandardEncoder::Error(StandardEncoder::Error::WeaveFailed, spec);
 }
 
+//-Instance Functions---------------------------------------------------------------------------------------------
+//Public:
+StandardEncoder::Error StandardEncoderPrivate::validate(const QImage& medium, const QIODevice& payloadSource, qint64 size)
+{
+    using namespace PxCryptPrivate;
+
+    // Ensure data was provided
+    if(size <= 0)
+        return StandardEncoder::Error(StandardEncoder::Error::MissingPayload);
+    if(!payloadSource.isReadable())
+        return StandardEncoder::Error(StandardEncoder::Error::MissingPayload, u"The payload source is not readable."_s);
+    if(static_cast<quint64>(size) > std::numeric_limits<StandardWork::payload_length_t>::max())
+        return StandardEncoder::Error(StandardEncoder::Error::WontFit, u"(payloads are limited to %1)."_s.arg(Utility::dataStr(std::numeric_limits<StandardWork::payload_length_t>::max())));
+
+    // Ensure bits-per-channel is valid (NOTE: optionally could clamp instead)
+    if(mBpc > BPC_MAX)
+        return StandardEncoder::Error(StandardEncoder::Error::InvalidBpc);
+
+    // Ensure image is valid
+    if(medium.isNull())
+        return StandardEncoder::Error(StandardEncoder::Error::InvalidImage);
+
+    // Measurements
+    Stat mediumStat(medium.size());
+    StandardWork::Measure measurement(mTag.size(), size);
+
+    if(mBpc == 0)// Determine BPC if auto
+    {
+        mBpc = measurement.minimumBpc(medium.size(), mRevision);
+        if(mBpc == 0)
+        {
+            // Check how short at max density
+            quint64 max = mediumStat.capacity(BPC_MAX, mRevision).bytes;
+            return StandardEncoder::Error(StandardEncoder::Error::WontFit, u"(%1 short)."_s.arg(Utility::dataStr(measurement.size() - max)));
+        }
+    }
+    else // Ensure data will fit with fixed BPC
+    {
+        quint64 max = mediumStat.capacity(mBpc, mRevision).bytes;
+        if(measurement.size() > max)
+            return StandardEncoder::Error(StandardEncoder::Error::WontFit, u"(%1 short)."_s.arg(Utility::dataStr(measurement.size() - max)));
+    }
+
+    return StandardEncoder::Error();
+}
+
+StandardEncoder::Error StandardEncoderPrivate::weave(QImage& image, QIODevice& payloadSource, qint64 size)
+{
+    using namespace PxCryptPrivate;
+
+    // Setup canvas, mark meta pixels, use self as reference if using relative encoding
+    Canvas canvas(image, mPsk);
+    canvas.setThreadCount(mThreads);
+    canvas.setBpc(mBpc);
+    canvas.setEncoding(mEncoding);
+    canvas.setRevision(mRevision);
+    canvas.setReference(mEncoding == StandardEncoder::Relative ? &image : nullptr);
+
+    // Prepare for IO
+    canvas.open(QIODevice::WriteOnly); // Closes upon destruction
+
+    // Write
+    StandardWork work(mTag, payloadSource, size);
+    ArtworkError wErr = work.writeToCanvas(canvas);
+    if(wErr)
+        return fromArtworkError(wErr);
+
+    return StandardEncoder::Error();
+}
+
 /*! @endcond */
 
 //===============================================================================================================
@@ -74,7 +153,9 @@ StandardEncoder::Error StandardEncoderPrivate::fromArtworkError(const PxCryptPri
  *  - BPC of 1
  *  - Empty pre-shared key
  *  - Absolute encoding
+ *  - Original format revision
  *  - Empty tag
+ *  - Single threaded
  */
 StandardEncoder::StandardEncoder() : Encoder(std::make_unique<StandardEncoderPrivate>()) {}
 
@@ -82,30 +163,30 @@ StandardEncoder::StandardEncoder() : Encoder(std::make_unique<StandardEncoderPri
 //Public:
 /*!
  *  Returns the maximum number of payload bytes that can be stored within an image of dimensions @a dim and tag of size
- *  @a tagSize when using @a bpc bits per channel.
+ *  @a tagSize when using @a bpc bits per channel and format revision @a rev.
  *
  *  @sa calculateOptimalDensity().
  */
-quint64 StandardEncoder::calculateMaximumPayload(const QSize& dim, quint16 tagSize, quint8 bpc)
+quint64 StandardEncoder::calculateMaximumPayload(const QSize& dim, quint16 tagSize, quint8 bpc, Revision rev)
 {
     PxCryptPrivate::StandardWork::Measure m(tagSize, 0); // 0 size payload to check for leftover
-    return m.leftOverSpace(dim, bpc);
+    return m.leftOverSpace(dim, bpc, rev);
 }
 
 /*!
  *  Returns the minimum number of bits per channel required to store a payload of @a payloadSize along with a tag
- *  of @a tagSize within a medium image of @a dim dimensions. @c 0 is returned if the payload/tag cannot fit within
- *  those dimensions.
+ *  of @a tagSize within a medium image of @a dim dimensions using format revision @a rev. @c 0 is returned if the
+ *  payload/tag cannot fit within those dimensions.
  *
  *  Using the lowest BPC necessary is optimal as it will produce in the least distortion per pixel and the most
  *  even spread of the encoded data, overall resulting in the most minimal visual disturbance of the original image.
  *
  *  @sa calculateMaximumStorage().
  */
-quint8 StandardEncoder::calculateOptimalDensity(const QSize& dim, quint16 tagSize, quint32 payloadSize)
+quint8 StandardEncoder::calculateOptimalDensity(const QSize& dim, quint16 tagSize, quint32 payloadSize, Revision rev)
 {
     PxCryptPrivate::StandardWork::Measure m(tagSize, payloadSize);
-    return m.minimumBpc(dim);
+    return m.minimumBpc(dim, rev);
 }
 
 //-Instance Functions----------------------------------------------------------------------------------------------
@@ -139,8 +220,10 @@ void StandardEncoder::setTag(const QByteArray& tag) { Q_D(StandardEncoder); d->m
  *  If the current BPC of the encoder is @c 0, the best BPC for the given medium and payload will be determined
  *  automatically. Then, the encoder's BPC is set to that ideal value.
  *
- *  The encoded image will always use the format `QImage::Format_ARGB32` or `QImage::Format_RGB32`
- *  (depending on if @a medium has an alpha channel) regardless of the format of @a medium.
+ *  The encoded image keeps the format of @a medium if it is one of `QImage::Format_ARGB32`, `QImage::Format_RGB32`,
+ *  `QImage::Format_RGBA8888`, `QImage::Format_RGBX8888`, `QImage::Format_RGB888` or `QImage::Format_BGR888`;
+ *  otherwise, it will use the format `QImage::Format_ARGB32` or `QImage::Format_RGB32` (depending on if @a medium
+ *  has an alpha channel).
  *
  *  @warning
  *  @parblock
@@ -159,67 +242,116 @@ void StandardEncoder::setTag(const QByteArray& tag) { Q_D(StandardEncoder); d->m
  */
 StandardEncoder::Error StandardEncoder::encode(QImage& encoded, QByteArrayView payload, const QImage& medium)
 {
-    using namespace PxCryptPrivate;
+    // Stream from memory, without copying
+    QByteArray raw = QByteArray::fromRawData(payload.data(), payload.size());
+    QBuffer source(&raw);
+    source.open(QIODevice::ReadOnly);
+
+    return encode(encoded, source, payload.size(), medium);
+}
 
+/*!
+ *  @overload
+ *
+ *  Reads @a size bytes of payload from @a payloadSource, which must already be open for reading, and encodes them
+ *  within the medium image @a medium, storing the result in @a encoded.
+ *
+ *  The payload is moved into the image a chunk at a time, with its checksum calculated along the way, so the
+ *  memory required does not grow with the size of the payload. This makes this overload preferable for large
+ *  payloads that reside in files. Reading starts from the source's current position.
+ *
+ *  If @a payloadSource provides fewer than @a size bytes, encoding fails with Error::WeaveFailed.
+ */
+StandardEncoder::Error StandardEncoder::encode(QImage& encoded, QIODevice& payloadSource, qint64 size, const QImage& medium)
+{
     Q_D(StandardEncoder);
 
     // Clear return buffer
     encoded = {};
 
-    // Ensure data was provided
-    if(payload.isEmpty())
-        return Error(Error::MissingPayload);
+    // Check the request against the medium as is first, so that invalid ones don't pay for a conversion
+    if(Error err = d->validate(medium, payloadSource, size))
+        return err;
 
-    // Ensure bits-per-channel is valid (NOTE: optionally could clamp instead)
-    if(d->mBpc > BPC_MAX)
-        return Error(Error::InvalidBpc);
+    // Copy base image, normalize to standard format
+    QImage workspace = standardizeImage(medium);
 
-    // Ensure image is valid
-    if(medium.isNull())
-        return Error(Error::InvalidImage);
+    Error err = d->weave(workspace, payloadSource, size);
+    if(!err)
+        encoded = workspace;
 
-    // Measurements
-    Stat mediumStat(medium);
-    StandardWork::Measure measurement(d->mTag.size(), payload.size());
+    return err;
+}
 
-    if(d->mBpc == 0)// Determine BPC if auto
-    {
-        d->mBpc = measurement.minimumBpc(medium.size());
-        if(d->mBpc == 0)
-        {
-            // Check how short at max density
-            quint64 max = mediumStat.capacity(BPC_MAX).bytes;
-            return Error(Error::WontFit, u"(%1 short)."_s.arg(Utility::dataStr(measurement.size() - max)));
-        }
-    }
-    else // Ensure data will fit with fixed BPC
-    {
-        quint64 max = mediumStat.capacity(d->mBpc).bytes;
-        if(measurement.size() > max)
-            return Error(Error::WontFit, u"(%1 short)."_s.arg(Utility::dataStr(measurement.size() - max)));
-    }
+/*!
+ *  Encodes @a payload within @a image directly, without first making a copy of it, then returns an error status.
+ *
+ *  This is otherwise equivalent to encode(), but avoids allocating a second full-resolution image and copying the
+ *  medium into it, which makes it preferable when the caller already holds the pixels in a suitable format and
+ *  does not need to keep the original.
+ *
+ *  @a image must use one of the 8-bit per channel formats that are accessed directly (e.g. `QImage::Format_ARGB32`
+ *  or `QImage::Format_RGB888`), else Error::InvalidImage is returned and the image is left untouched. Pixel data owned
+ *  by the caller can be encoded in place by wrapping it with one of the QImage constructors that take a non-const
+ *  @c uchar* buffer and a bytes-per-line value; padding at the end of each scan line is left as is.
+ *
+ *  Images whose scan lines are padded, which includes any 3 byte per pixel image whose lines aren't a multiple of
+ *  4 bytes long, are encoded through a packed copy that is written back to @a image once the payload is woven in,
+ *  so only images without padding avoid the copy.
+ *
+ *  Because the image is written as the payload is woven in, it may be left partially modified if encoding fails
+ *  after validation (i.e. with Error::WeaveFailed). As always with QImage, if @a image shares its data with another
+ *  instance it will be detached first, so the data is only truly encoded in place when @a image is its sole owner.
+ *
+ *  @warning
+ *  Images encoded with the Encoder::Relative strategy can only be decoded with the original medium at hand, which
+ *  this function overwrites. When using that strategy, keep a copy of the original image before calling this
+ *  function, or use encode() instead.
+ *
+ *  @sa encode().
+ */
+StandardEncoder::Error StandardEncoder::encodeInPlace(QImage& image, QByteArrayView payload)
+{
+    // Stream from memory, without copying
+    QByteArray raw = QByteArray::fromRawData(payload.data(), payload.size());
+    QBuffer source(&raw);
+    source.open(QIODevice::ReadOnly);
 
-    // Copy base image, normalize to standard format
-    QImage workspace = standardizeImage(medium);
+    return encodeInPlace(image, source, payload.size());
+}
 
-    // Setup canvas, mark meta pixels, use self as reference if using relative encoding
-    Canvas canvas(workspace, d->mPsk);
-    canvas.setBpc(d->mBpc);
-    canvas.setEncoding(d->mEncoding);
-    canvas.setReference(d->mEncoding == Relative ? &workspace : nullptr);
+/*!
+ *  @overload
+ *
+ *  Reads @a size bytes of payload from @a payloadSource, which must already be open for reading, and encodes them
+ *  within @a image directly.
+ *
+ *  @sa encode(QImage&, QIODevice&, qint64, const QImage&).
+ */
+StandardEncoder::Error StandardEncoder::encodeInPlace(QImage& image, QIODevice& payloadSource, qint64 size)
+{
+    Q_D(StandardEncoder);
 
-    // Prepare for IO
-    canvas.open(QIODevice::WriteOnly); // Closes upon destruction
+    // Same checks, in the same order, as encode()
+    if(Error err = d->validate(image, payloadSource, size))
+        return err;
 
-    // Write
-    StandardWork work(d->mTag, payload.toByteArray());
-    ArtworkError wErr = work.writeToCanvas(canvas);
-    if(wErr)
-        return d->fromArtworkError(wErr);
+    // Only pixels already in a natively supported format can be used directly
+    if(!PxCryptPrivate::PxGrid::supports(image.format()))
+        return Error(Error::InvalidImage, u"In-place encoding requires an 8-bit per channel RGB(A) format."_s);
 
-    encoded = workspace;
+    // Pixels are only addressed directly without padding, otherwise work on a packed copy and write it back in one go
+    if(!PxCryptPrivate::PxGrid::isPacked(image))
+    {
+        QImage packed = PxCryptPrivate::standardizeImage(image);
+        if(Error err = d->weave(packed, payloadSource, size))
+            return err;
+
+        PxCryptPrivate::copyPixels(image, packed);
+        return Error();
+    }
 
-    return Error();
+    return d->weave(image, payloadSource, size);
 }
 
 //===============================================================================================================
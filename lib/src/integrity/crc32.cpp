@@ -0,0 +1,366 @@
+// Unit Include
+#include "crc32.h"
+
+// Standard Library Includes
+#include <array>
+#include <cstring>
+
+// Qt Includes
+#include <QtEndian>
+
+// Platform Includes
+#if defined(Q_PROCESSOR_X86) && (defined(Q_CC_GNU) || defined(Q_CC_CLANG) || defined(Q_CC_MSVC))
+    #define PXCRYPT_CRC32_PCLMUL
+    #include <immintrin.h>
+    #if defined(Q_CC_MSVC) && !defined(Q_CC_CLANG)
+        #include <intrin.h>
+        #define PXCRYPT_TARGET_PCLMUL
+    #else
+        #define PXCRYPT_TARGET_PCLMUL __attribute__((target("pclmul,sse4.1")))
+    #endif
+#endif
+
+#if defined(Q_PROCESSOR_ARM_64) && (defined(Q_CC_GNU) || defined(Q_CC_CLANG)) && (defined(Q_OS_LINUX) || defined(Q_OS_DARWIN))
+    #define PXCRYPT_CRC32_ARMV8
+    #include <arm_acle.h>
+    #if defined(Q_OS_LINUX)
+        #include <sys/auxv.h>
+        #ifndef HWCAP_CRC32
+            #define HWCAP_CRC32 (1 << 7)
+        #endif
+    #endif
+    #if defined(Q_CC_CLANG)
+        #define PXCRYPT_TARGET_CRC __attribute__((target("crc")))
+    #else
+        #define PXCRYPT_TARGET_CRC __attribute__((target("+crc")))
+    #endif
+#endif
+
+namespace PxCryptPrivate
+{
+
+namespace
+{
+
+constexpr quint32 POLYNOMIAL = 0xEDB88320; // Reversed 0x04C11DB7
+constexpr quint32 INITIAL = 0xFFFFFFFF;
+constexpr quint32 FINAL_XOR = 0xFFFFFFFF;
+
+// SLICES[0] is the classic byte-wise table, SLICES[k] advances a byte through k further zero bytes
+constexpr std::array<std::array<quint32, 256>, 16> SLICES = []{
+    std::array<std::array<quint32, 256>, 16> t{};
+    for(quint32 i = 0; i < 256; i++)
+    {
+        quint32 c = i;
+        for(int k = 0; k < 8; k++)
+            c = (c & 1) ? (c >> 1) ^ POLYNOMIAL : c >> 1;
+        t[0][i] = c;
+    }
+
+    for(int s = 1; s < 16; s++)
+        for(quint32 i = 0; i < 256; i++)
+            t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFF];
+
+    return t;
+}();
+
+//-Kernels----------------------------------------------------------------------------------------------------------
+/* Each kernel advances the raw (un-inverted) CRC state over 'len' bytes, so they can be mixed freely, i.e.
+ * for the unaligned ends of a buffer.
+ */
+using Update = quint32(*)(quint32 state, const quint8* data, qsizetype len);
+
+quint32 bytewiseUpdate(quint32 c, const quint8* data, qsizetype len)
+{
+    for(qsizetype i = 0; i < len; ++i)
+        c = SLICES[0][(c ^ data[i]) & 0xFF] ^ (c >> 8);
+    return c;
+}
+
+quint32 slicedUpdate(quint32 c, const quint8* data, qsizetype len)
+{
+    /* Slicing-by-16: the state is folded into the first four bytes of each 16 byte stride and every byte is
+     * then looked up in the table that accounts for how many bytes follow it, so the lookups are independent
+     * of each other instead of forming one long dependency chain.
+     */
+    const auto& t = SLICES;
+    for(; len >= 16; data += 16, len -= 16)
+    {
+        quint32 a = qFromLittleEndian<quint32>(data) ^ c;
+        quint32 b = qFromLittleEndian<quint32>(data + 4);
+        quint32 d = qFromLittleEndian<quint32>(data + 8);
+        quint32 e = qFromLittleEndian<quint32>(data + 12);
+        c = t[15][a & 0xFF] ^ t[14][(a >> 8) & 0xFF] ^ t[13][(a >> 16) & 0xFF] ^ t[12][a >> 24] ^
+            t[11][b & 0xFF] ^ t[10][(b >> 8) & 0xFF] ^ t[9][(b >> 16) & 0xFF] ^ t[8][b >> 24] ^
+            t[7][d & 0xFF] ^ t[6][(d >> 8) & 0xFF] ^ t[5][(d >> 16) & 0xFF] ^ t[4][d >> 24] ^
+            t[3][e & 0xFF] ^ t[2][(e >> 8) & 0xFF] ^ t[1][(e >> 16) & 0xFF] ^ t[0][e >> 24];
+    }
+
+    return bytewiseUpdate(c, data, len);
+}
+
+#ifdef PXCRYPT_CRC32_PCLMUL
+bool hasPclmul()
+{
+#if defined(Q_CC_MSVC) && !defined(Q_CC_CLANG)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 1)) && (info[2] & (1 << 19)); // PCLMULQDQ, SSE4.1
+#else
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#endif
+}
+
+PXCRYPT_TARGET_PCLMUL inline __m128i pclmulLoad(const quint8* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+
+PXCRYPT_TARGET_PCLMUL inline __m128i pclmulFold(__m128i x, __m128i k, __m128i next)
+{
+    __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+    __m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+}
+
+PXCRYPT_TARGET_PCLMUL quint32 pclmulUpdate(quint32 c, const quint8* data, qsizetype len)
+{
+    /* Folding as described in Intel's "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+     * Instruction", with the bit-reflected constants for this polynomial (as used by zlib and Chromium).
+     * Four 128-bit lanes are folded forward 64 bytes at a time, then into one lane, which is finally
+     * reduced to 32 bits with Barrett reduction. Short buffers aren't worth the setup.
+     */
+    if(len < 64)
+        return slicedUpdate(c, data, len);
+
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163cd6124);
+    const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+    const __m128i low32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    __m128i x1 = _mm_xor_si128(pclmulLoad(data), _mm_cvtsi32_si128(static_cast<int>(c)));
+    __m128i x2 = pclmulLoad(data + 16);
+    __m128i x3 = pclmulLoad(data + 32);
+    __m128i x4 = pclmulLoad(data + 48);
+    data += 64;
+    len -= 64;
+
+    // Fold 64 bytes at a time
+    for(; len >= 64; data += 64, len -= 64)
+    {
+        x1 = pclmulFold(x1, k1k2, pclmulLoad(data));
+        x2 = pclmulFold(x2, k1k2, pclmulLoad(data + 16));
+        x3 = pclmulFold(x3, k1k2, pclmulLoad(data + 32));
+        x4 = pclmulFold(x4, k1k2, pclmulLoad(data + 48));
+    }
+
+    // Fold lanes into one, then the rest 16 bytes at a time
+    x1 = pclmulFold(x1, k3k4, x2);
+    x1 = pclmulFold(x1, k3k4, x3);
+    x1 = pclmulFold(x1, k3k4, x4);
+    for(; len >= 16; data += 16, len -= 16)
+        x1 = pclmulFold(x1, k3k4, pclmulLoad(data));
+
+    // 128 to 64 bits
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, low32), k5k0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, low32), poly, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, low32), poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    c = static_cast<quint32>(_mm_extract_epi32(x1, 1));
+
+    return slicedUpdate(c, data, len);
+}
+#endif
+
+#ifdef PXCRYPT_CRC32_ARMV8
+bool hasArmv8Crc()
+{
+#if defined(Q_OS_DARWIN)
+    return true; // Every Apple ARM64 CPU has them
+#else
+    return getauxval(AT_HWCAP) & HWCAP_CRC32;
+#endif
+}
+
+PXCRYPT_TARGET_CRC quint32 armv8Update(quint32 c, const quint8* data, qsizetype len)
+{
+    // The instructions use the same polynomial and bit order, so they're a drop in for the table
+    for(; len > 0 && (reinterpret_cast<quintptr>(data) & 7); ++data, --len)
+        c = __crc32b(c, *data);
+
+    for(; len >= 8; data += 8, len -= 8)
+    {
+        quint64 v;
+        std::memcpy(&v, data, sizeof(v));
+        c = __crc32d(c, v);
+    }
+
+    for(; len > 0; ++data, --len)
+        c = __crc32b(c, *data);
+
+    return c;
+}
+#endif
+
+Update updateFor(Crc32::Kernel kernel)
+{
+    switch(kernel)
+    {
+#ifdef PXCRYPT_CRC32_PCLMUL
+        case Crc32::Kernel::Pclmul:
+            return pclmulUpdate;
+#endif
+#ifdef PXCRYPT_CRC32_ARMV8
+        case Crc32::Kernel::Armv8:
+            return armv8Update;
+#endif
+        default:
+            return slicedUpdate;
+    }
+}
+
+Update activeUpdate()
+{
+    static const Update update = updateFor(Crc32::kernel());
+    return update;
+}
+
+using Gf2Matrix = std::array<quint32, 32>;
+
+quint32 gf2Times(const Gf2Matrix& mat, quint32 vec)
+{
+    quint32 sum = 0;
+    for(int i = 0; vec; ++i, vec >>= 1)
+        if(vec & 1)
+            sum ^= mat[i];
+    return sum;
+}
+
+void gf2Square(Gf2Matrix& square, const Gf2Matrix& mat)
+{
+    for(int i = 0; i < 32; ++i)
+        square[i] = gf2Times(mat, mat[i]);
+}
+
+}
+
+//===============================================================================================================
+// Crc32
+//===============================================================================================================
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+Crc32::Crc32() :
+    mState(INITIAL)
+{}
+
+//-Class Functions----------------------------------------------------------------------------------------------
+//Public:
+Crc32::Kernel Crc32::kernel()
+{
+    static const Kernel best = []{
+        for(Kernel k : {Kernel::Armv8, Kernel::Pclmul})
+            if(isSupported(k))
+                return k;
+        return Kernel::Sliced;
+    }();
+
+    return best;
+}
+
+bool Crc32::isSupported(Kernel kernel)
+{
+    switch(kernel)
+    {
+        case Kernel::Sliced:
+            return true;
+        case Kernel::Pclmul:
+#ifdef PXCRYPT_CRC32_PCLMUL
+            return hasPclmul();
+#else
+            return false;
+#endif
+        case Kernel::Armv8:
+#ifdef PXCRYPT_CRC32_ARMV8
+            return hasArmv8Crc();
+#else
+            return false;
+#endif
+    }
+
+    Q_UNREACHABLE();
+}
+
+quint32 Crc32::compute(QByteArrayView data)
+{
+    Crc32 crc;
+    crc.update(data);
+    return crc.value();
+}
+
+quint32 Crc32::compute(QByteArrayView data, Kernel kernel)
+{
+    // For comparing kernels, regardless of which one is in use
+    Q_ASSERT(isSupported(kernel));
+    const quint8* bytes = reinterpret_cast<const quint8*>(data.data());
+    return updateFor(kernel)(INITIAL, bytes, data.size()) ^ FINAL_XOR;
+}
+
+quint32 Crc32::combine(quint32 crcA, quint32 crcB, quint64 lengthB)
+{
+    /* Appending lengthB zero bytes to A is a linear operation on its CRC, so it can be expressed as a 32x32 matrix
+     * over GF(2). The matrix for a single zero bit is squared repeatedly to get those for 1, 2, 4... zero bytes and
+     * the ones matching the set bits of lengthB are applied, making this O(log(lengthB)). What's left is then
+     * just to XOR in the CRC of B.
+     */
+    if(lengthB == 0)
+        return crcA;
+
+    Gf2Matrix even; // Even powers of two zeros operator
+    Gf2Matrix odd; // Odd powers of two zeros operator
+
+    // Operator for one zero bit
+    odd[0] = POLYNOMIAL;
+    quint32 row = 1;
+    for(int i = 1; i < 32; ++i, row <<= 1)
+        odd[i] = row;
+
+    gf2Square(even, odd); // Two zero bits
+    gf2Square(odd, even); // Four zero bits
+
+    // Apply zero bytes to A, the first square puts the operator for one zero byte in 'even'
+    do
+    {
+        gf2Square(even, odd);
+        if(lengthB & 1)
+            crcA = gf2Times(even, crcA);
+        lengthB >>= 1;
+        if(lengthB == 0)
+            break;
+
+        gf2Square(odd, even);
+        if(lengthB & 1)
+            crcA = gf2Times(odd, crcA);
+        lengthB >>= 1;
+    }
+    while(lengthB != 0);
+
+    return crcA ^ crcB;
+}
+
+//-Instance Functions--------------------------------------------------------------------------------------------
+//Public:
+void Crc32::reset() { mState = INITIAL; }
+
+void Crc32::update(QByteArrayView data)
+{
+    mState = activeUpdate()(mState, reinterpret_cast<const quint8*>(data.data()), data.size());
+}
+
+quint32 Crc32::value() const { return mState ^ FINAL_XOR; }
+
+}
@@ -0,0 +1,55 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+// Qt Includes
+#include <QByteArrayView>
+
+namespace PxCryptPrivate
+{
+
+/* Incremental CRC-32 (IEEE 802.3, reflected, as used by zlib/PNG), for data that is only ever seen a chunk
+ * at a time. Produces the same result as Qx::Integrity::crc32() over the concatenation of all updates.
+ *
+ * CRCs of separate blocks can also be joined with combine() (zlib's crc32_combine()), which only needs the
+ * length of the second block, not its data.
+ *
+ * The fastest kernel the CPU supports is picked the first time one is needed; every kernel produces the
+ * same result.
+ */
+class Crc32
+{
+//-Class Enums------------------------------------------------------------------------------------------------------
+public:
+    enum class Kernel : quint8
+    {
+        Sliced, // Slicing-by-16 tables, always available
+        Pclmul, // Carry-less multiplication folding (x86 PCLMULQDQ and SSE4.1)
+        Armv8 // ARMv8 CRC32 instructions
+    };
+
+//-Instance Variables------------------------------------------------------------------------------------------------------
+private:
+    quint32 mState;
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    Crc32();
+
+//-Class Functions----------------------------------------------------------------------------------------------
+public:
+    static Kernel kernel();
+    static bool isSupported(Kernel kernel);
+    static quint32 compute(QByteArrayView data);
+    static quint32 compute(QByteArrayView data, Kernel kernel);
+    static quint32 combine(quint32 crcA, quint32 crcB, quint64 lengthB);
+
+//-Instance Functions----------------------------------------------------------------------------------------------
+public:
+    void reset();
+    void update(QByteArrayView data);
+    quint32 value() const;
+};
+
+}
+
+#endif // CRC32_H
@@ -1,6 +1,9 @@
 // Unit Include
 #include "canvas.h"
 
+// Qt Includes
+#include <QtConcurrent>
+
 namespace PxCryptPrivate
 {
 
@@ -10,11 +13,12 @@ namespace PxCryptPrivate
 
 //-Constructor---------------------------------------------------------------------------------------------------------
 //Public:
-Canvas::Canvas(QImage& image, const QByteArray& psk) :
+Canvas::Canvas(QImage& image, const QByteArray& psk, PxScheduleCache* scheduleCache) :
     mSize(image.size()),
-    mMetaAccess(image, !psk.isEmpty() ? psk : DEFAULT_SEED),
+    mMetaAccess(image, !psk.isEmpty() ? psk : DEFAULT_SEED, scheduleCache),
     mPxAccess(image, mMetaAccess),
-    mTranslator(mPxAccess)
+    mThreads(1),
+    mReadOrder(ReadOrder::TraversalOrder)
 {}
 
 //-Destructor---------------------------------------------------------------------------------------------------
@@ -25,6 +29,63 @@ Canvas::~Canvas() { close(); }
 //Private:
 void Canvas::_reset() { mPxAccess.reset(); }
 
+template<typename F>
+qint64 Canvas::translate(qint64 len, F translation)
+{
+    /* Performs 'translation(translator, offset, length)' over 'len' bytes from the current position, splitting
+     * the work across threads when there's enough of it. Each byte's location depends only on its position in
+     * the traversal, so once the traversal data up to the end is built, runs that start and end on a pixel
+     * boundary cover disjoint sets of pixels and can be processed independently by forked accessors, with a
+     * result identical to doing it in one go.
+     */
+    qint64 span = PARALLEL_MIN_BYTES;
+    if(mThreads < 2 || len < span * 2)
+        return translation(*mTranslator, 0, len);
+
+    // Lead in, up to the first block (pixel and byte aligned) boundary
+    qint64 blockBytes = mTranslator->blockBytes();
+    qint64 start = dataPosition();
+    qint64 done = translation(*mTranslator, 0, (blockBytes - (start % blockBytes)) % blockBytes);
+
+    // Divide as many whole blocks as are available between threads
+    qint64 bulk = std::min(len - done, static_cast<qint64>(mPxAccess.remainingBits() / 8));
+    qint64 blocks = bulk / blockBytes;
+    qint64 runs = std::min<qint64>(mThreads, (blocks * blockBytes) / span);
+    if(runs > 1)
+    {
+        struct Run { qint64 offset; qint64 length; };
+        QList<Run> work;
+        for(qint64 r = 0, prev = 0; r < runs; r++)
+        {
+            qint64 next = (blocks * (r + 1)) / runs;
+            work.append(Run{done + prev * blockBytes, (next - prev) * blockBytes});
+            prev = next;
+        }
+
+        // Shared traversal data must be complete and the canvas current before forking
+        quint64 endBits = (start + done + blocks * blockBytes) * 8;
+        mPxAccess.suspendBuffer();
+        mPxAccess.prepare(endBits);
+
+        quint8 b = bpc();
+        Encoding e = encoding();
+        QtConcurrent::blockingMap(work, [&](const Run& run){
+            PxAccess access = mPxAccess.fork((start + run.offset) * 8);
+            std::unique_ptr<DataTranslator> translator = DataTranslator::create(access, b, e);
+            translator->setReadOrder(mReadOrder);
+            [[maybe_unused]] qint64 processed = translation(*translator, run.offset, run.length);
+            Q_ASSERT(processed == run.length); // Always within the available space
+            access.flush();
+        });
+
+        mPxAccess.seek(endBits);
+        done += blocks * blockBytes;
+    }
+
+    // Remainder
+    return done + translation(*mTranslator, done, len - done);
+}
+
 //Protected:
 qint64 Canvas::readData(char* data, qint64 maxlen)
 {
@@ -37,15 +98,10 @@ qint64 Canvas::readData(char* data, qint64 maxlen)
         return -1;
     }
 
-    qint64 i;
-    for(i = 0; i < maxlen && !mPxAccess.atEnd(); i++)
-    {
-        char& byte = data[i];
-        if(!mTranslator.skimByte(reinterpret_cast<quint8&>(byte)))
-            break; // prevents i++
-    }
-
-    return i;
+    quint8* out = reinterpret_cast<quint8*>(data);
+    return translate(maxlen, [out](DataTranslator& translator, qint64 offset, qint64 length){
+        return translator.skim(out + offset, length);
+    });
 }
 
 qint64 Canvas::skipData(qint64 maxSize)
@@ -62,13 +118,10 @@ qint64 Canvas::writeData(const char* data, qint64 len)
         return -1;
     }
 
-    qint64 i;
-    for(i = 0; i < len && !mPxAccess.atEnd(); i++)
-    {
-        quint8 byte = data[i];
-        if(!mTranslator.weaveByte(byte))
-            break; // prevents i++
-    }
+    const quint8* in = reinterpret_cast<const quint8*>(data);
+    qint64 i = translate(len, [in](DataTranslator& translator, qint64 offset, qint64 length){
+        return translator.weave(in + offset, length);
+    });
 
     // Always ensure data is current if Unbuffered is used
     if(openMode().testFlag(QIODevice::Unbuffered))
@@ -94,6 +147,12 @@ bool Canvas::open(OpenMode mode)
         mPxAccess.setReferenceImage(nullptr); // Force-clear reference when it's not needed
     _reset();
 
+    // Select translator once so that the hot paths never need to branch on BPC, encoding or pixel layout
+    mTranslator = DataTranslator::create(mPxAccess, bpc(), e);
+    if(!mTranslator)
+        return false;
+    mTranslator->setReadOrder(mReadOrder);
+
     // Base implementation
     return QIODevice::open(mode);
 }
@@ -105,12 +164,116 @@ void Canvas::close()
 }
 
 bool Canvas::atEnd() const { return mPxAccess.atEnd(); }
+qint64 Canvas::bytesAvailable() const
+{
+    // Anything not yet skimmed, plus whatever QIODevice has buffered
+    return isReadable() ? (mPxAccess.remainingBits() / 8) + QIODevice::bytesAvailable() : 0;
+}
+
+qint64 Canvas::weave(std::span<const std::byte> data)
+{
+    /* Writes data straight to the translator, skipping QIODevice's write() and its bookkeeping, which is worth
+     * it for large spans such as payload bodies. QIODevice never buffers writes for this device, so this can be
+     * freely interleaved with write() (e.g. through a QDataStream for the surrounding fields).
+     */
+    Q_ASSERT(openMode().testFlag(QIODevice::WriteOnly));
+    if(data.empty() || mPxAccess.atEnd())
+        return 0;
+
+    const quint8* in = reinterpret_cast<const quint8*>(data.data());
+    qint64 woven = translate(data.size(), [in](DataTranslator& translator, qint64 offset, qint64 length){
+        return translator.weave(in + offset, length);
+    });
+
+    if(openMode().testFlag(QIODevice::Unbuffered))
+        mPxAccess.flush();
+
+    return woven;
+}
+
+qint64 Canvas::skim(std::span<std::byte> data)
+{
+    /* The reading counterpart of weave(). Reads through QIODevice fill its buffer ahead of what was asked for,
+     * so whatever is sitting there is handed out first in order for this to be interleaved with read().
+     */
+    Q_ASSERT(openMode().testFlag(QIODevice::ReadOnly));
+
+    char* out = reinterpret_cast<char*>(data.data());
+    qint64 len = data.size();
+    qint64 buffered = std::min(QIODevice::bytesAvailable(), len);
+    if(buffered > 0 && read(out, buffered) != buffered)
+        return -1;
+
+    if(buffered == len || mPxAccess.atEnd())
+        return buffered;
+
+    quint8* rest = reinterpret_cast<quint8*>(out + buffered);
+    return buffered + translate(len - buffered, [rest](DataTranslator& translator, qint64 offset, qint64 length){
+        return translator.skim(rest + offset, length);
+    });
+}
+
+qint64 Canvas::dataPosition() const
+{
+    /* Byte offset of the traversal within the canvas' data. Unlike pos(), which is meaningless for sequential
+     * devices, this is always accurate for writes; reads however may be ahead of what has been consumed due to
+     * QIODevice's internal buffering.
+     */
+    return mPxAccess.bitPosition() / 8;
+}
+
+qint64 Canvas::reserve(qint64 size)
+{
+    /* Writes 'size' zero bytes as a placeholder for data that isn't known yet and returns their position, or -1
+     * if they didn't fit. Zeros leave the canvas untouched when using relative encoding, so the only pixels
+     * whose original values could be lost before the placeholder is filled are the ones at either end that
+     * are shared with neighboring data.
+     */
+    Q_ASSERT(openMode().testFlag(QIODevice::WriteOnly) && size >= 0);
+
+    qint64 position = dataPosition();
+    mPxAccess.preserveOriginal();
+    QByteArray zeros(size, '\0');
+    if(write(zeros) != size)
+        return -1;
+    mPxAccess.preserveOriginal();
+
+    return position;
+}
+
+bool Canvas::fill(qint64 position, QByteArrayView data)
+{
+    // Weaves data into a placeholder created with reserve() and then returns to the current position
+    Q_ASSERT(openMode().testFlag(QIODevice::WriteOnly));
+    Q_ASSERT(position >= 0 && position + data.size() <= dataPosition());
+
+    quint64 resume = mPxAccess.bitPosition();
+    if(mPxAccess.seek(position * 8) != static_cast<quint64>(position * 8))
+        return false;
+
+    qint64 written = mTranslator->weave(reinterpret_cast<const quint8*>(data.data()), data.size());
+    mPxAccess.seek(resume);
+
+    return written == data.size();
+}
 
 Canvas::metavalue_t Canvas::bpc() const { return mMetaAccess.bpc(); }
 Canvas::Encoding Canvas::encoding() const { return static_cast<Encoding>(mMetaAccess.enc()); }
+Canvas::Revision Canvas::revision() const { return static_cast<Revision>(mMetaAccess.rev()); }
+bool Canvas::hasValidRevision() const { return mMetaAccess.revValid(); }
 
 void Canvas::setBpc(metavalue_t bpc) { mMetaAccess.setBpc(bpc); }
 void Canvas::setEncoding(Encoding enc) { mMetaAccess.setEnc(enc); }
+void Canvas::setRevision(Revision rev) { mMetaAccess.setRev(rev); }
 void Canvas::setReference(const QImage* ref) { mPxAccess.setReferenceImage(ref); }
+void Canvas::setThreadCount(int threads) { mThreads = threads > 0 ? threads : QThread::idealThreadCount(); }
+
+void Canvas::setReadOrder(ReadOrder order)
+{
+    // Only affects reads, and takes effect immediately if already open
+    mReadOrder = order;
+    if(mTranslator)
+        mTranslator->setReadOrder(order);
+}
 
 }
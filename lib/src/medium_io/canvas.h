@@ -1,12 +1,16 @@
 #ifndef CANVAS_H
 #define CANVAS_H
 
+// Standard Library Includes
+#include <span>
+
 // Qt Includes
 #include <QImage>
 #include <QIODevice>
 
 // Project Includes
 #include "pxcrypt/codec/encoder.h"
+#include "pxcrypt/codec/decoder.h"
 #include "medium_io/operate/meta_access.h"
 #include "medium_io/operate/px_access.h"
 #include "medium_io/operate/data_translator.h"
@@ -21,6 +25,8 @@ class Canvas final : public QIODevice
 //-Aliases----------------------------------------------------------------------------------------------------------
 private:
     using Encoding = PxCrypt::Encoder::Encoding;
+    using Revision = PxCrypt::Encoder::Revision;
+    using ReadOrder = PxCrypt::Decoder::ReadOrder;
 
 public:
     using metavalue_t = quint8;
@@ -28,17 +34,20 @@ public:
 //-Class Variables----------------------------------------------------------------------------------------------
 private:
     static inline const QByteArray DEFAULT_SEED = "The best and most secure seed that is possible to exist!"_ba;
+    static constexpr qint64 PARALLEL_MIN_BYTES = 64 * 1024; // Smallest span worth handing to another thread
 
 //-Instance Variables----------------------------------------------------------------------------------------------
 private:
     QSize mSize;
     MetaAccess mMetaAccess;
     PxAccess mPxAccess;
-    DataTranslator mTranslator;
+    std::unique_ptr<DataTranslator> mTranslator; // Specialized for the current BPC/encoding/layout upon open
+    int mThreads;
+    ReadOrder mReadOrder;
 
 //-Constructor---------------------------------------------------------------------------------------------------
 public:
-    Canvas(QImage& image, const QByteArray& psk = {});
+    Canvas(QImage& image, const QByteArray& psk = {}, PxScheduleCache* scheduleCache = nullptr);
 
 //-Destructor---------------------------------------------------------------------------------------------------
 public:
@@ -48,6 +57,9 @@ public:
 private:
     void _reset(); // Don't overlap with QIODevice::reset()
 
+    template<typename F>
+    qint64 translate(qint64 len, F translation);
+
 protected:
     qint64 readData(char* data, qint64 maxlen) override;
     qint64 skipData(qint64 maxSize) override;
@@ -59,14 +71,29 @@ public:
     bool open(OpenMode mode) override;
     void close() override;
     bool atEnd() const override;
+    qint64 bytesAvailable() const override;
+
+    // Bulk
+    qint64 weave(std::span<const std::byte> data);
+    qint64 skim(std::span<std::byte> data);
+
+    // Random access
+    qint64 dataPosition() const;
+    qint64 reserve(qint64 size);
+    bool fill(qint64 position, QByteArrayView data);
 
     // Other
     metavalue_t bpc() const;
     Encoding encoding() const;
+    Revision revision() const;
+    bool hasValidRevision() const;
 
     void setBpc(metavalue_t bpc);
     void setEncoding(Encoding enc);
+    void setRevision(Revision rev);
     void setReference(const QImage* ref = nullptr);
+    void setThreadCount(int threads);
+    void setReadOrder(ReadOrder order);
 };
 
 }
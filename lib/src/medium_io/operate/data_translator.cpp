@@ -1,112 +1,422 @@
 // Unit Include
 #include "data_translator.h"
 
+// Standard Library Includes
+#include <bit>
+#include <numeric>
+#include <vector>
+
+// Qx Includes
+#include <qx/core/qx-algorithm.h>
+#include <qx/utility/qx-concepts.h>
+
 namespace PxCryptPrivate
 {
 /*! @cond */ //TODO: Doxygen bug, this shouldn't be needed because namespace is excluded
+
+namespace
+{
+
 //===============================================================================================================
-// DataTranslator
+// SpecializedTranslator
 //===============================================================================================================
 
-//-Constructor---------------------------------------------------------------------------------------------------------
-//Public:
-DataTranslator::DataTranslator(PxAccess& access) :
-    mAccess(access)
-{}
-
-//-Instance Functions--------------------------------------------------------------------------------------------
-//Private:
-template<typename F>
-    requires Qx::defines_call_for_s<F, void, int, int>
-bool DataTranslator::translate(F procedure)
+template<quint8 Bpc, PxCrypt::Encoder::Encoding Enc, typename Layout>
+class SpecializedTranslator final : public DataTranslator
 {
-    int byteBitIdx = 0;
+    static_assert(Bpc >= BPC_MIN && Bpc <= BPC_MAX);
+
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    static constexpr bool RELATIVE = Enc == Encoding::Relative;
+    static constexpr int PX_BITS = Bpc * 3;
+    static constexpr quint64 PX_MASK = (1ULL << PX_BITS) - 1;
+    static constexpr quint32 FIELD_MASK = (1U << Bpc) - 1;
+    static constexpr quint64 BLOCK_BITS = std::lcm(PX_BITS, 8); // Smallest span that starts and ends on both a byte and pixel boundary
+    static constexpr qint64 BLOCK_BYTES = BLOCK_BITS / 8;
+    static constexpr quint64 SCATTER_PIXELS = 1 << 20; // Pixels resolved at once when reading in memory order, keeps runs byte aligned
+    static constexpr int SCATTER_BUCKET_BITS = 12;
 
-    while(byteBitIdx < 8 && !mAccess.atEnd())
+//-Inner Struct-----------------------------------------------------------------------------------------------------------
+private:
+    struct Scatter
     {
-        // Determine how many bits can be used
-        int remaining = 8 - byteBitIdx;
-        int available = mAccess.availableBits();
-        int processing = std::min(remaining, available);
+        qint64 px;
+        quint32 offset; // Pixels into the run
+        std::array<Channel, 3> channels;
+    };
 
-        // Perform procedure
-        procedure(processing, byteBitIdx);
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    SpecializedTranslator(PxAccess& access) : DataTranslator(access) {}
+
+//-Instance Functions----------------------------------------------------------------------------------------------
+private:
+    template<typename F>
+        requires Qx::defines_call_for_s<F, void, int, int>
+    bool translate(F procedure)
+    {
+        int byteBitIdx = 0;
+
+        while(byteBitIdx < 8 && !mAccess.atEnd())
+        {
+            // Determine how many bits can be used
+            int remaining = 8 - byteBitIdx;
+            int available = Bpc - mAccess.bitIndex();
+            int processing = std::min(remaining, available);
+
+            // Perform procedure
+            procedure(processing, byteBitIdx);
+
+            // Update state
+            byteBitIdx += processing;
 
-        // Update state
-        byteBitIdx += processing;
+            // Move access forward
+            mAccess.advanceBits(processing);
+        }
 
-        // Move access forward
-        mAccess.advanceBits(processing);
+        return byteBitIdx == 8;
     }
 
-    return byteBitIdx == 8;
-}
+    void weaveBits(quint8 bits, int count)
+    {
+        int chBitIdx = mAccess.bitIndex();
 
-void DataTranslator::weaveBits(quint8 bits, int count)
-{
-    int chBitIdx = mAccess.bitIndex();
+        // Align bits with destination start
+        bits <<= chBitIdx;
 
-    // Align bits with destination start
-    bits <<= chBitIdx;
+        // Update bits
+        quint8& val = mAccess.bufferedValue();
+        if constexpr(RELATIVE)
+        {
+            if(mAccess.originalValue() > 127)
+                val -= bits;
+            else
+                val += bits;
+        }
+        else
+        {
+            quint8 clearMask = ~(((0b1 << count) - 1) << chBitIdx);
+            val = (val & clearMask) | bits;
+        }
+    }
 
-    // Update bits
-    quint8& val = mAccess.bufferedValue();
-    if(mAccess.hasReferenceImage()) // Relative method
+    quint8 skimBits(int count)
     {
-        if(mAccess.originalValue() > 127)
-            val -= bits;
+        int chBitIdx = mAccess.bitIndex();
+        quint8 keepMask = ((0b1 << count) - 1) << chBitIdx;
+
+        quint8 bits;
+        if constexpr(RELATIVE)
+            bits = Qx::distance(mAccess.referenceValue(), mAccess.constBufferedValue()) & keepMask;
         else
-            val += bits;
+            bits = mAccess.constBufferedValue() & keepMask;
+
+        // Drop already processed bits
+        return bits >> chBitIdx;
     }
-    else // Absolute method
+
+    void weaveBlock(const quint8* data, qint64 len)
     {
-        quint8 clearMask = ~(((0b1 << count) - 1) << chBitIdx);
-        val = (val & clearMask) | bits;
+        /* Equivalent to weaveByte() over the whole block, but works on whole pixels. The payload is packed
+         * into a 64-bit accumulator from which each pixel's 3 * Bpc bits are taken at once and split into
+         * per channel fields, in traversal order, with the pixel written back once all channels are updated.
+         *
+         * Must start on a pixel boundary and cover a whole number of pixels.
+         */
+        Q_ASSERT(mAccess.atPixelStart() && (len * 8) % PX_BITS == 0);
+
+        const quint8* in = data;
+        const quint8* end = data + len;
+        quint64 pixels = (len * 8) / PX_BITS;
+        quint64 acc = 0;
+        int accBits = 0;
+
+        mAccess.suspendBuffer();
+        for(quint64 p = 0; p < pixels; p++)
+        {
+            // Top up accumulator
+            if(accBits < PX_BITS)
+            {
+                while(accBits <= 56 && in != end)
+                {
+                    acc |= static_cast<quint64>(*in++) << accBits;
+                    accBits += 8;
+                }
+            }
+
+            quint32 pxBits = acc & PX_MASK;
+            acc >>= PX_BITS;
+            accBits -= PX_BITS;
+
+            PxAccess::WholePixel px = mAccess.takePixel<Layout>();
+            QRgb val = px.value;
+            for(int i = 0; i < 3; i++)
+            {
+                int shift = channelShift(px.channels[i]);
+                quint32 field = (pxBits >> (i * Bpc)) & FIELD_MASK;
+
+                if constexpr(RELATIVE)
+                {
+                    quint8 orig = static_cast<quint8>(val >> shift);
+                    quint8 woven = static_cast<quint8>(orig > 127 ? orig - field : orig + field);
+                    val = (val & ~(0xFFU << shift)) | (static_cast<QRgb>(woven) << shift);
+                }
+                else
+                    val = (val & ~(FIELD_MASK << shift)) | (field << shift);
+            }
+            px.value = val;
+            mAccess.storePixel<Layout>(px);
+        }
+        mAccess.resumeBuffer();
     }
-}
 
-quint8 DataTranslator::skimBits(int count)
-{
-    int chBitIdx = mAccess.bitIndex();
-    quint8 keepMask = ((0b1 << count) - 1) << chBitIdx;
+    quint32 pixelBits(const PxAccess::WholePixel& px) const
+    {
+        // All of a pixel's fields, in traversal order
+        quint32 pxBits = 0;
+        for(int i = 0; i < 3; i++)
+        {
+            Channel ch = px.channels[i];
+            quint32 field;
+            if constexpr(RELATIVE)
+                field = Qx::distance(channelValue(px.reference, ch), channelValue(px.value, ch)) & FIELD_MASK;
+            else
+                field = channelValue(px.value, ch) & FIELD_MASK;
 
-    quint8 bits;
-    if(mAccess.hasReferenceImage()) // Relative method
-        bits = Qx::distance(mAccess.referenceValue(), mAccess.constBufferedValue()) & keepMask;
-    else // Absolute method
-        bits = mAccess.constBufferedValue() & keepMask;
+            pxBits |= field << (i * Bpc);
+        }
 
-    // Drop already processed bits
-    return bits >> chBitIdx;
-}
+        return pxBits;
+    }
 
-//Public:
-bool DataTranslator::weaveByte(quint8 byte)
+    void skimBlock(quint8* data, qint64 len)
+    {
+        // The inverse of weaveBlock(), with the same requirements
+        Q_ASSERT(mAccess.atPixelStart() && (len * 8) % PX_BITS == 0);
+
+        quint8* out = data;
+        quint64 pixels = (len * 8) / PX_BITS;
+        quint64 acc = 0;
+        int accBits = 0;
+
+        mAccess.suspendBuffer();
+        for(quint64 p = 0; p < pixels; p++)
+        {
+            acc |= static_cast<quint64>(pixelBits(mAccess.takePixel<Layout>())) << accBits;
+            accBits += PX_BITS;
+
+            // Drain whole bytes
+            while(accBits >= 8)
+            {
+                *out++ = static_cast<quint8>(acc);
+                acc >>= 8;
+                accBits -= 8;
+            }
+        }
+        Q_ASSERT(accBits == 0);
+        mAccess.resumeBuffer();
+    }
+
+    void skimBlockScattered(quint8* data, qint64 len)
+    {
+        /* Equivalent to skimBlock(), but reads the canvas in memory order instead of traversal order. A run of
+         * the traversal is resolved up front, without touching the canvas, and its pixels are then sorted by
+         * their location so that they're loaded roughly front to back, with each pixel's bits being scattered
+         * to its offset within the output. This trades random reads across the whole canvas for random writes
+         * within the run's share of the output, which is far smaller. A coarse counting sort is enough to keep
+         * the reads local, and keeps the cost of sorting linear.
+         */
+        Q_ASSERT(mAccess.atPixelStart() && (len * 8) % PX_BITS == 0);
+
+        quint64 pixels = (len * 8) / PX_BITS;
+        std::vector<Scatter> gathered(std::min(pixels, SCATTER_PIXELS));
+        std::vector<Scatter> sorted(gathered.size());
+        std::vector<quint32> buckets((1 << SCATTER_BUCKET_BITS) + 1);
+
+        mAccess.suspendBuffer();
+        for(quint64 done = 0; done < pixels; done += SCATTER_PIXELS)
+        {
+            quint32 run = static_cast<quint32>(std::min(pixels - done, SCATTER_PIXELS));
+            quint8* out = data + (done * PX_BITS) / 8;
+
+            // Resolve run
+            qint64 last = 0;
+            for(quint32 p = 0; p < run; p++)
+            {
+                CanvasTraverser::PixelSelection sel = mAccess.takeSelection();
+                gathered[p] = {.px = sel.px, .offset = p, .channels = sel.channels};
+                last = std::max(last, sel.px);
+            }
+
+            // Sort into buckets by location
+            int shift = std::max(0, static_cast<int>(std::bit_width(static_cast<quint64>(last))) - SCATTER_BUCKET_BITS);
+            std::fill(buckets.begin(), buckets.end(), 0);
+            for(quint32 p = 0; p < run; p++)
+                buckets[(gathered[p].px >> shift) + 1]++;
+            std::partial_sum(buckets.begin(), buckets.end(), buckets.begin());
+            for(quint32 p = 0; p < run; p++)
+                sorted[buckets[gathered[p].px >> shift]++] = gathered[p];
+
+            // Scatter, neighboring pixels may share a byte so bits are merged into cleared output
+            std::fill_n(out, (static_cast<quint64>(run) * PX_BITS) / 8, 0);
+            for(quint32 p = 0; p < run; p++)
+            {
+                const Scatter& s = sorted[p];
+                quint32 pxBits = pixelBits(mAccess.pixelAt<Layout>({.px = s.px, .channels = s.channels}));
+                quint64 bit = static_cast<quint64>(s.offset) * PX_BITS;
+                quint8* o = out + bit / 8;
+                for(quint32 v = pxBits << (bit % 8); v; v >>= 8)
+                    *o++ |= static_cast<quint8>(v);
+            }
+        }
+        mAccess.resumeBuffer();
+    }
+
+    qint64 blockableBytes(qint64 len) const
+    {
+        // Number of bytes (a whole number of blocks) that can be processed in bulk from the current position
+        if(mAccess.atEnd() || mAccess.bitPosition() % BLOCK_BITS != 0)
+            return 0;
+
+        quint64 blocks = std::min(static_cast<quint64>(len) * 8, mAccess.remainingBits()) / BLOCK_BITS;
+        return blocks * BLOCK_BYTES;
+    }
+
+public:
+    qint64 blockBytes() const override { return BLOCK_BYTES; }
+
+    bool weaveByte(quint8 byte) override
+    {
+        return translate([byte, this](int weaving, int alreadyWoven){
+            // Extract bits
+            quint8 extractMask = (1 << weaving) - 1;
+            quint8 bits = (byte >> alreadyWoven) & extractMask;
+
+            // Weave bits into canvas
+            weaveBits(bits, weaving);
+        });
+    }
+
+    bool skimByte(quint8& byte) override
+    {
+        // Clear return buffer
+        byte = 0;
+
+        return translate([&byte, this](int skimming, int alreadySkimmed){
+            // Skim bits
+            quint8 bits = skimBits(skimming);
+
+            // Merge into byte
+            byte |= bits << alreadySkimmed;
+        });
+    }
+
+    qint64 weave(const quint8* data, qint64 len) override
+    {
+        qint64 i = 0;
+
+        // Byte-wise until aligned for bulk processing (or entirely, if too short)
+        while(i < len && blockableBytes(len - i) == 0)
+        {
+            if(mAccess.atEnd() || !weaveByte(data[i]))
+                return i;
+            i++;
+        }
+
+        // Bulk
+        if(qint64 bulk = blockableBytes(len - i); bulk > 0)
+        {
+            weaveBlock(data + i, bulk);
+            i += bulk;
+        }
+
+        // Remainder
+        for(; i < len && !mAccess.atEnd(); i++)
+            if(!weaveByte(data[i]))
+                break;
+
+        return i;
+    }
+
+    qint64 skim(quint8* data, qint64 len) override
+    {
+        qint64 i = 0;
+
+        // Byte-wise until aligned for bulk processing (or entirely, if too short)
+        while(i < len && blockableBytes(len - i) == 0)
+        {
+            if(mAccess.atEnd() || !skimByte(data[i]))
+                return i;
+            i++;
+        }
+
+        // Bulk
+        if(qint64 bulk = blockableBytes(len - i); bulk > 0)
+        {
+            if(mReadOrder == ReadOrder::MemoryOrder)
+                skimBlockScattered(data + i, bulk);
+            else
+                skimBlock(data + i, bulk);
+            i += bulk;
+        }
+
+        // Remainder
+        for(; i < len && !mAccess.atEnd(); i++)
+            if(!skimByte(data[i]))
+                break;
+
+        return i;
+    }
+};
+
+template<PxCrypt::Encoder::Encoding Enc, typename Layout>
+std::unique_ptr<DataTranslator> createSpecialized(PxAccess& access, quint8 bpc)
 {
-    return translate([byte, this](int weaving, int alreadyWoven){
-        // Extract bits
-        quint8 extractMask = (1 << weaving) - 1;
-        quint8 bits = (byte >> alreadyWoven) & extractMask;
+    switch(bpc)
+    {
+        case 1: return std::make_unique<SpecializedTranslator<1, Enc, Layout>>(access);
+        case 2: return std::make_unique<SpecializedTranslator<2, Enc, Layout>>(access);
+        case 3: return std::make_unique<SpecializedTranslator<3, Enc, Layout>>(access);
+        case 4: return std::make_unique<SpecializedTranslator<4, Enc, Layout>>(access);
+        case 5: return std::make_unique<SpecializedTranslator<5, Enc, Layout>>(access);
+        case 6: return std::make_unique<SpecializedTranslator<6, Enc, Layout>>(access);
+        case 7: return std::make_unique<SpecializedTranslator<7, Enc, Layout>>(access);
+        default:
+            qCritical("Invalid BPC!");
+            return nullptr;
+    }
+}
 
-        // Weave bits into canvas
-        weaveBits(bits, weaving);
-    });
 }
 
-bool DataTranslator::skimByte(quint8& byte)
-{
-    // Clear return buffer
-    byte = 0;
+//===============================================================================================================
+// DataTranslator
+//===============================================================================================================
 
-    return translate([&byte, this](int skimming, int alreadySkimmed){
-        // Skim bits
-        quint8 bits = skimBits(skimming);
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Protected:
+DataTranslator::DataTranslator(PxAccess& access) :
+    mAccess(access),
+    mReadOrder(ReadOrder::TraversalOrder)
+{}
 
-        // Merge into byte
-        byte |= bits << alreadySkimmed;
+//-Class Functions------------------------------------------------------------------------------------------------
+//Public:
+std::unique_ptr<DataTranslator> DataTranslator::create(PxAccess& access, quint8 bpc, Encoding enc)
+{
+    Q_ASSERT((enc == Encoding::Relative) == access.hasReferenceImage());
+
+    return PxGrid::withLayout(access.layout(), [&]<typename L>(L){
+        return enc == Encoding::Relative ? createSpecialized<Encoding::Relative, L>(access, bpc) :
+                                           createSpecialized<Encoding::Absolute, L>(access, bpc);
     });
 }
 
+//-Instance Functions----------------------------------------------------------------------------------------------
+//Public:
+void DataTranslator::setReadOrder(ReadOrder order) { mReadOrder = order; }
+
 /*! @endcond */
 
 }
@@ -1,41 +1,57 @@
 #ifndef DATA_TRANSLATOR_H
 #define DATA_TRANSLATOR_H
 
-// Qt Includes
-#include <QRandomGenerator>
-
-// Qx Includes
-#include <qx/utility/qx-concepts.h>
+// Standard Library Includes
+#include <memory>
 
 // Project Includes
+#include "pxcrypt/codec/encoder.h"
+#include "pxcrypt/codec/decoder.h"
 #include "medium_io/operate/px_access.h"
 
 namespace PxCryptPrivate
 {
 /*! @cond */
 
+/* Moves payload bytes into and out of the canvas. The actual work is done by an implementation specialized for
+ * the canvas' BPC, encoding and pixel layout, chosen once when the canvas is opened, so that the masks, encoding
+ * method and pixel accesses are fixed at compile time instead of being checked for every bit group.
+ */
 class DataTranslator
 {
+//-Aliases----------------------------------------------------------------------------------------------------------
+protected:
+    using Encoding = PxCrypt::Encoder::Encoding;
+    using ReadOrder = PxCrypt::Decoder::ReadOrder;
+
 //-Instance Variables------------------------------------------------------------------------------------------------------
-private:
+protected:
     PxAccess& mAccess;
+    ReadOrder mReadOrder;
 
 //-Constructor---------------------------------------------------------------------------------------------------------
-public:
+protected:
     DataTranslator(PxAccess& access);
 
-//-Instance Functions----------------------------------------------------------------------------------------------
-private:
-    template<typename F>
-        requires Qx::defines_call_for_s<F, void, int, int>
-    bool translate(F procedure);
+//-Destructor---------------------------------------------------------------------------------------------------------
+public:
+    virtual ~DataTranslator() = default;
 
-    void weaveBits(quint8 bits, int count);
-    quint8 skimBits(int count);
+//-Class Functions----------------------------------------------------------------------------------------------
+public:
+    static std::unique_ptr<DataTranslator> create(PxAccess& access, quint8 bpc, Encoding enc);
 
+//-Instance Functions----------------------------------------------------------------------------------------------
 public:
-    bool weaveByte(quint8 byte);
-    bool skimByte(quint8& byte);
+    virtual qint64 blockBytes() const = 0;
+
+    virtual bool weaveByte(quint8 byte) = 0;
+    virtual bool skimByte(quint8& byte) = 0;
+
+    virtual qint64 weave(const quint8* data, qint64 len) = 0;
+    virtual qint64 skim(quint8* data, qint64 len) = 0;
+
+    void setReadOrder(ReadOrder order);
 };
 
 /*! @endcond */
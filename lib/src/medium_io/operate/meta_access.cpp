@@ -41,42 +41,33 @@ void MetaRef::operator=(quint8 value)
 
 //-Constructor---------------------------------------------------------------------------------------------------------
 //Public:
-MetaAccess::MetaAccess(QImage& image, const QByteArray& psk) :
-    mTraverser(image, psk),
-    mPixels(reinterpret_cast<QRgb*>(image.bits())),
+MetaAccess::MetaAccess(QImage& image, const QByteArray& psk, PxScheduleCache* scheduleCache) :
+    mTraverser(image, psk, scheduleCache),
+    mPixels(PxGrid::of(image)),
     mBpcRef({&ncr(), &ncr(), &ncr()}),
     mBpcCache(*mBpcRef),
     mEncRef({&ncr(), &ncr(), &ncr()}),
-    mEncCache(*mEncRef)
+    mEncCache(*mEncRef),
+    mRevRef(mTraverser.pixelTotal() > META_PIXEL_COUNT ? std::make_optional(MetaRef({&ncr(), &ncr(), &ncr()})) : std::nullopt),
+    mRevCache((mEncCache & REVISED_FLAG) && mRevRef ? **mRevRef : 0),
+    mRevValid(!(mEncCache & REVISED_FLAG) || mRevCache)
 {
+    /* The revision pixel is always located, but only belongs to the metadata when the encoding pixel is flagged;
+     * otherwise it's the first data pixel of an original format image, which is left alone. A flagged image
+     * must name an actual revision, so one without room for it or with a revision of 0 is malformed.
+     */
+
     // TODO: Have this check or a more complete one in Canvas cause this occurs too late due to initializers
     //Q_ASSERT(image.width() * image.height() >= META_PIXEL_COUNT);
 }
 
 //-Class Functions------------------------------------------------------------------------------------------------
-//Private:
-quint8& MetaAccess::channelRef(QRgb& pixel, Channel ch)
-{
-    // As of Qt 6.7, QRgb is brazenly defined as 'unsigned int', despite that not being guaranteed to be 32-bit, so make sure
-    static_assert(sizeof(pixel) == 4);
-
-    // Dirty direct memory access, but meh, base it on system endianness and we're good
-    quint8* chPtr = reinterpret_cast<quint8*>(&pixel);
-    if constexpr(QSysInfo::ByteOrder == QSysInfo::BigEndian) // 0xAARRGGBB
-        chPtr += ch;
-    else // 0xBBGGRRAA
-        chPtr += (3 - ch);
-
-    return *chPtr;
-}
-
 //Public:
-int MetaAccess::metaPixelCount() { return META_PIXEL_COUNT; }
+int MetaAccess::metaPixelCount(quint8 rev) { return rev ? REVISED_META_PIXEL_COUNT : META_PIXEL_COUNT; }
 
 //-Instance Functions--------------------------------------------------------------------------------------------
 //Private:
-QRgb& MetaAccess::currentPixelRef() { return mPixels[mTraverser.pixelIndex()]; }
-quint8& MetaAccess::currentChannelRef() { return channelRef(currentPixelRef(), mTraverser.channel()); }
+quint8& MetaAccess::currentChannelRef() { return *mPixels.channel(mTraverser.pixelIndex(), mTraverser.channel()); }
 quint8& MetaAccess::ncr()
 {
     quint8& v = currentChannelRef();
@@ -93,12 +84,31 @@ void MetaAccess::setBpc(quint8 bpc)
 
 void MetaAccess::setEnc(quint8 enc)
 {
-    mEncCache = enc;
-    mEncRef = enc;
+    Q_ASSERT(!(enc & ~ENC_MASK));
+    mEncCache = (mRevCache ? REVISED_FLAG : 0) | enc;
+    mEncRef = mEncCache;
+}
+
+void MetaAccess::setRev(quint8 rev)
+{
+    if(rev)
+    {
+        Q_ASSERT(mRevRef);
+        mEncCache |= REVISED_FLAG;
+        *mRevRef = rev;
+    }
+    else
+        mEncCache &= ~REVISED_FLAG;
+
+    mEncRef = mEncCache;
+    mRevCache = rev;
+    mRevValid = true;
 }
 
 quint8 MetaAccess::bpc() const { return mBpcCache; }
-quint8 MetaAccess::enc() const { return mEncCache; }
+quint8 MetaAccess::enc() const { return mEncCache & ENC_MASK; }
+quint8 MetaAccess::rev() const { return mRevCache; }
+bool MetaAccess::revValid() const { return mRevValid; }
 CanvasTraverserPrime& MetaAccess::surrenderTraverser() { return mTraverser; }
 
 }
@@ -1,8 +1,12 @@
 #ifndef META_ACCESS_H
 #define META_ACCESS_H
 
+// Standard Library Includes
+#include <optional>
+
 // Project Includes
 #include "medium_io/traverse/canvas_traverser_prime.h"
+#include "medium_io/operate/px_grid.h"
 
 namespace PxCryptPrivate
 {
@@ -34,38 +38,45 @@ class MetaAccess
 //-Class Variables------------------------------------------------------------------------------------------------------
 private:
     static const int META_PIXEL_COUNT = 2; // BPC + EncType
+    static const int REVISED_META_PIXEL_COUNT = 3; // + Revision
+
+    // The encoding pixel only needs its lower bits for the type, the top one marks a revised format
+    static const quint8 ENC_MASK = 0b011;
+    static const quint8 REVISED_FLAG = 0b100;
 
 //-Instance Variables------------------------------------------------------------------------------------------------------
 private:
     CanvasTraverserPrime mTraverser;
-    QRgb* mPixels;
+    PxGrid mPixels;
     MetaRef mBpcRef;
     quint8 mBpcCache;
     MetaRef mEncRef;
     quint8 mEncCache;
+    std::optional<MetaRef> mRevRef; // Only if the image has room for it
+    quint8 mRevCache;
+    bool mRevValid;
 
 //-Constructor---------------------------------------------------------------------------------------------------------
 public:
-    MetaAccess(QImage& image, const QByteArray& psk);
+    MetaAccess(QImage& image, const QByteArray& psk, PxScheduleCache* scheduleCache = nullptr);
 
 //-Class Functions----------------------------------------------------------------------------------------------
-private:
-    static quint8& channelRef(QRgb& pixel, Channel ch);
-
 public:
-    static int metaPixelCount();
+    static int metaPixelCount(quint8 rev = 0);
 
 //-Instance Functions----------------------------------------------------------------------------------------------
 private:
-    QRgb& currentPixelRef();
     quint8& currentChannelRef();
     quint8& ncr(); // Get next channel reference
 
 public:
     void setBpc(quint8 bpc);
     void setEnc(quint8 enc);
+    void setRev(quint8 rev);
     quint8 bpc() const;
     quint8 enc() const;
+    quint8 rev() const;
+    bool revValid() const;
 
     CanvasTraverserPrime& surrenderTraverser();
 };
@@ -14,9 +14,10 @@ namespace PxCryptPrivate
 //-Constructor---------------------------------------------------------------------------------------------------------
 //Public:
 PxAccess::PxAccess(QImage& canvas, MetaAccess& metaAccess) :
-    mPixels(reinterpret_cast<QRgb*>(canvas.bits())),
-    mRefPixels(nullptr),
+    mPixels(PxGrid::of(canvas)),
+    mRefPixels(),
     mTraverser(metaAccess),
+    mOriginal(0),
     mNeedFlush(false)
 {
     Q_ASSERT(!canvas.isNull());
@@ -24,24 +25,32 @@ PxAccess::PxAccess(QImage& canvas, MetaAccess& metaAccess) :
 
 //-Instance Functions--------------------------------------------------------------------------------------------
 //Private:
-QRgb& PxAccess::canvasPixel() { return mPixels[mTraverser.pixelIndex()]; }
-const QRgb& PxAccess::constCanvasPixel() const { return mPixels[mTraverser.pixelIndex()]; }
-quint8 PxAccess::canvasRed() const { return qRed(constCanvasPixel()); }
-quint8 PxAccess::canvasGreen() const { return qGreen(constCanvasPixel()); }
-quint8 PxAccess::canvasBlue() const { return qBlue(constCanvasPixel()); }
-quint8 PxAccess::canvasAlpha() const { return qAlpha(constCanvasPixel()); }
-
-const QRgb& PxAccess::referencePixel() const{ return mRefPixels[mTraverser.pixelIndex()]; }
-quint8 PxAccess::referenceRed() const { return qRed(referencePixel()); }
-quint8 PxAccess::referenceGreen() const { return qGreen(referencePixel()); }
-quint8 PxAccess::referenceBlue() const { return qBlue(referencePixel()); }
+void PxAccess::prefetchUpcoming() const
+{
+    /* Pixels are visited in a pseudo-random order, so on canvases larger than the cache nearly every one is a
+     * miss. Requesting the pixel that will be needed a few pixels from now overlaps those misses with the
+     * work on the ones in between.
+     */
+    qint64 px = mTraverser.upcomingPixelIndex(PREFETCH_DISTANCE);
+    if(px < 0)
+        return;
+
+    mPixels.prefetch(px);
+    if(hasReferenceImage())
+        mRefPixels.prefetch(px);
+}
 
 void PxAccess::fillBuffer()
 {
-    mBuffer[Channel::Red] = canvasRed();
-    mBuffer[Channel::Green] = canvasGreen();
-    mBuffer[Channel::Blue] = canvasBlue();
-    mBuffer[Channel::Alpha] = canvasAlpha();
+    prefetchUpcoming();
+
+    qint64 px = mTraverser.pixelIndex();
+    QRgb current = mPixels.load(px);
+    mOriginal = mPreserved.value(px, current);
+    mBuffer[Channel::Red] = qRed(current);
+    mBuffer[Channel::Green] = qGreen(current);
+    mBuffer[Channel::Blue] = qBlue(current);
+    mBuffer[Channel::Alpha] = qAlpha(current);
 }
 
 void PxAccess::flushBuffer()
@@ -51,28 +60,33 @@ void PxAccess::flushBuffer()
 
     Q_ASSERT(mTraverser.pixelIndex() >= 0); // Can flush when not at frame end, but not when off frame
 
-    canvasPixel() = qRgba(mBuffer[Channel::Red],
-                          mBuffer[Channel::Green],
-                          mBuffer[Channel::Blue],
-                          mBuffer[Channel::Alpha]);
+    mPixels.store(mTraverser.pixelIndex(), qRgba(mBuffer[Channel::Red],
+                                                 mBuffer[Channel::Green],
+                                                 mBuffer[Channel::Blue],
+                                                 mBuffer[Channel::Alpha]));
     mNeedFlush = false;
 }
 
 //Public:
-bool PxAccess::hasReferenceImage() const { return mRefPixels; }
+PxGrid::Layout PxAccess::layout() const { return mPixels.layout(); }
+bool PxAccess::hasReferenceImage() const { return !mRefPixels.isNull(); }
 int PxAccess::availableBits() const { return mTraverser.remainingChannelBits(); }
 int PxAccess::bitIndex() const { return mTraverser.channelBitIndex(); };
 bool PxAccess::atEnd() const { return mTraverser.atEnd(); }
+quint64 PxAccess::bitPosition() const { return mTraverser.bitPosition(); }
+quint64 PxAccess::remainingBits() const { return mTraverser.remainingBits(); }
+bool PxAccess::atPixelStart() const { return mTraverser.atPixelStart(); }
 
 void PxAccess::setReferenceImage(const QImage* ref)
 {
-    mRefPixels = ref ? reinterpret_cast<const QRgb*>(ref->bits()) : nullptr;
+    mRefPixels = ref ? ConstPxGrid::of(*ref) : ConstPxGrid();
 }
 
 void PxAccess::reset()
 {
     // Ensure canvas is current
     flushBuffer();
+    mPreserved.clear();
 
     // Re-initialize canvas traverser
     mTraverser.init();
@@ -96,6 +110,48 @@ qint64 PxAccess::skip(qint64 bytes)
     return skipped;
 }
 
+quint64 PxAccess::seek(quint64 bitPos)
+{
+    // Ensure canvas is current, without losing track of the current pixel's original value if it's being left part way
+    if(mNeedFlush)
+        preserveOriginal();
+    flushBuffer();
+
+    // Seek
+    quint64 actual = mTraverser.seek(bitPos);
+
+    // Fill if not at end
+    if(!atEnd())
+        fillBuffer();
+
+    return actual;
+}
+
+void PxAccess::preserveOriginal()
+{
+    /* Relative weaving decides the direction of each channel's shift from its original value, which is only
+     * available from the canvas until the pixel is flushed. Pixels that will be woven into again after that
+     * (i.e. ones shared by a placeholder and its neighbors) must have their original recorded here first.
+     */
+    if(!atEnd())
+        mPreserved.insert(mTraverser.pixelIndex(), mOriginal);
+}
+
+void PxAccess::prepare(quint64 bitPos) { mTraverser.prepare(bitPos); }
+
+PxAccess PxAccess::fork(quint64 bitPos) const
+{
+    /* An independent accessor over the same canvas, positioned at 'bitPos', for working on a separate region
+     * concurrently. This one must be flushed and prepare() called through the end of the furthest region first,
+     * and regions must not share pixels.
+     */
+    Q_ASSERT(!mNeedFlush);
+
+    PxAccess forked(*this);
+    forked.seek(bitPos);
+    return forked;
+}
+
 void PxAccess::advanceBits(int bitCount)
 {
     bool cycleBuffer = mTraverser.bitAdvanceWillChangePixel(bitCount);
@@ -116,40 +172,25 @@ quint8& PxAccess::bufferedValue()
 
 quint8 PxAccess::constBufferedValue() const { return mBuffer[mTraverser.channel()]; }
 
-quint8 PxAccess::originalValue() const
-{
-    switch(mTraverser.channel())
-    {
-    case Channel::Red:
-        return canvasRed();
-    case Channel::Green:
-        return canvasGreen();
-    case Channel::Blue:
-        return canvasBlue();
-
-    default:
-        qCritical("Illegal channel in rotation");
-    }
+quint8 PxAccess::originalValue() const { return channelValue(mOriginal, mTraverser.channel()); }
+quint8 PxAccess::referenceValue() const { return *mRefPixels.channel(mTraverser.pixelIndex(), mTraverser.channel()); }
 
-    return 0; // Never reached
+void PxAccess::suspendBuffer()
+{
+    // Pixels are about to be accessed directly, so make sure the canvas is current
+    flushBuffer();
 }
 
-quint8 PxAccess::referenceValue() const
+void PxAccess::resumeBuffer()
 {
-    switch(mTraverser.channel())
-    {
-        case Channel::Red:
-            return referenceRed();
-        case Channel::Green:
-            return referenceGreen();
-        case Channel::Blue:
-            return referenceBlue();
-
-        default:
-            qCritical("Illegal channel in rotation");
-    }
+    if(!atEnd())
+        fillBuffer();
+}
 
-    return 0; // Never reached
+CanvasTraverser::PixelSelection PxAccess::takeSelection()
+{
+    // Like takePixel(), but only resolves which pixel is next so that it can be loaded later via pixelAt()
+    return mTraverser.takePixel();
 }
 
 }
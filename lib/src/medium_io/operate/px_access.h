@@ -1,8 +1,12 @@
 #ifndef PX_ACCESS_H
 #define PX_ACCESS_H
 
+// Qt Includes
+#include <QHash>
+
 // Project Includes
 #include "medium_io/traverse/canvas_traverser.h"
+#include "medium_io/operate/px_grid.h"
 
 namespace PxCryptPrivate
 {
@@ -11,34 +15,42 @@ class MetaAccess;
 
 class PxAccess
 {
+//-Inner Struct-----------------------------------------------------------------------------------------------------------
+public:
+    struct WholePixel
+    {
+        qint64 index;
+        QRgb value;
+        QRgb reference; // Only meaningful when a reference image is set
+        std::array<Channel, 3> channels;
+    };
+
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    // How many pixels ahead of the current one to prefetch, as far as the sequence looks ahead
+    static constexpr quint64 PREFETCH_DISTANCE = PxSequenceGenerator::LOOKAHEAD;
+
 //-Instance Variables------------------------------------------------------------------------------------------------------
 private:
-    QRgb* mPixels;
-    const QRgb* mRefPixels;
+    PxGrid mPixels;
+    ConstPxGrid mRefPixels;
     CanvasTraverser mTraverser;
 
     std::array<quint8, 4> mBuffer;
+    QRgb mOriginal;
     bool mNeedFlush;
 
+    // Original values of partially woven pixels that may be revisited, see preserveOriginal()
+    QHash<qint64, QRgb> mPreserved;
+
 //-Constructor---------------------------------------------------------------------------------------------------------
 public:
     PxAccess(QImage& canvas, MetaAccess& metaAccess);
 
 //-Instance Functions----------------------------------------------------------------------------------------------
 private:
-    // Original canvas pixel access
-    QRgb& canvasPixel();
-    const QRgb& constCanvasPixel() const;
-    quint8 canvasRed() const;
-    quint8 canvasGreen() const;
-    quint8 canvasBlue() const;
-    quint8 canvasAlpha() const;
-
-    // Reference canvas pixel access
-    const QRgb& referencePixel() const;
-    quint8 referenceRed() const;
-    quint8 referenceGreen() const;
-    quint8 referenceBlue() const;
+    // Prefetch
+    void prefetchUpcoming() const;
 
     // Buffer
     void fillBuffer();
@@ -46,15 +58,23 @@ private:
 
 public:
     // Stat
+    PxGrid::Layout layout() const;
     bool hasReferenceImage() const;
     int availableBits() const;
     int bitIndex() const;
     bool atEnd() const;
+    quint64 bitPosition() const;
+    quint64 remainingBits() const;
+    bool atPixelStart() const;
 
     // Manipulation
     void setReferenceImage(const QImage* ref);
     void reset();
     qint64 skip(qint64 bytes);
+    quint64 seek(quint64 bitPos);
+    void preserveOriginal();
+    void prepare(quint64 bitPos);
+    PxAccess fork(quint64 bitPos) const;
     void advanceBits(int bitCount);
     void flush();
 
@@ -63,6 +83,33 @@ public:
     quint8 constBufferedValue() const;
     quint8 originalValue() const;
     quint8 referenceValue() const;
+
+    // Whole pixel access, bypasses the buffer; these are specialized for the canvas' layout (see layout())
+    void suspendBuffer();
+    void resumeBuffer();
+    CanvasTraverser::PixelSelection takeSelection();
+
+    template<typename L>
+    WholePixel takePixel()
+    {
+        prefetchUpcoming();
+        return pixelAt<L>(mTraverser.takePixel());
+    }
+
+    template<typename L>
+    WholePixel pixelAt(const CanvasTraverser::PixelSelection& sel) const
+    {
+        // The reference image can be in any layout, but is only read
+        return {
+            .index = sel.px,
+            .value = mPixels.load<L>(sel.px),
+            .reference = hasReferenceImage() ? mRefPixels.load(sel.px) : 0,
+            .channels = sel.channels
+        };
+    }
+
+    template<typename L>
+    void storePixel(const WholePixel& pixel) { mPixels.store<L>(pixel.index, pixel.value); }
 };
 
 }
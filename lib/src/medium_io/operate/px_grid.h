@@ -0,0 +1,263 @@
+#ifndef PX_GRID_H
+#define PX_GRID_H
+
+// Standard Library Includes
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+// Qt Includes
+#include <QImage>
+#include <QSysInfo>
+#if defined(Q_CC_MSVC) && defined(Q_PROCESSOR_X86)
+#include <xmmintrin.h>
+#endif
+
+// Project Includes
+#include "codec/encdec.h"
+
+namespace PxCryptPrivate
+{
+
+/* Compile time description of how a pixel's channels are laid out in memory, as byte offsets from the start
+ * of the pixel. Pixels are always handed out as QRgb (0xAARRGGBB) regardless, so nothing above the grid has to
+ * care about the image's actual format. Layouts without an alpha channel read as opaque and ignore alpha on write.
+ */
+template<int Bytes, int R, int G, int B, int A = -1>
+struct PxLayout
+{
+//-Class Variables------------------------------------------------------------------------------------------------------
+    static constexpr int BYTES = Bytes;
+    static constexpr bool HAS_ALPHA = A >= 0;
+    static constexpr std::array<int, CH_COUNT> OFFSETS{A, R, G, B}; // Indexed by Channel
+
+    // Pixels that are QRgb values in native byte order can be moved as a whole
+    static constexpr bool NATIVE = Bytes == 4 && (QSysInfo::ByteOrder == QSysInfo::BigEndian ?
+                                                  (A == 0 && R == 1 && G == 2 && B == 3) :
+                                                  (A == 3 && R == 2 && G == 1 && B == 0));
+
+//-Class Functions----------------------------------------------------------------------------------------------
+    static constexpr int offset(Channel ch) { return OFFSETS[ch]; }
+
+    static QRgb load(const uchar* px)
+    {
+        if constexpr(NATIVE)
+        {
+            QRgb v;
+            std::memcpy(&v, px, sizeof(v));
+            return v;
+        }
+        else
+        {
+            QRgb a;
+            if constexpr(HAS_ALPHA)
+                a = px[A];
+            else
+                a = 0xFF;
+
+            return (a << 24) | (QRgb(px[R]) << 16) | (QRgb(px[G]) << 8) | QRgb(px[B]);
+        }
+    }
+
+    static void store(uchar* px, QRgb value)
+    {
+        if constexpr(NATIVE)
+            std::memcpy(px, &value, sizeof(value));
+        else
+        {
+            if constexpr(HAS_ALPHA)
+                px[A] = qAlpha(value);
+            px[R] = qRed(value);
+            px[G] = qGreen(value);
+            px[B] = qBlue(value);
+        }
+    }
+};
+
+// QRgb in native byte order (Format_ARGB32/RGB32)
+using Argb32Layout = std::conditional_t<QSysInfo::ByteOrder == QSysInfo::BigEndian,
+                                        PxLayout<4, 1, 2, 3, 0>,
+                                        PxLayout<4, 2, 1, 0, 3>>;
+using Rgba8888Layout = PxLayout<4, 0, 1, 2, 3>; // Format_RGBA8888/RGBX8888
+using Rgb888Layout = PxLayout<3, 0, 1, 2>; // Format_RGB888
+using Bgr888Layout = PxLayout<3, 2, 1, 0>; // Format_BGR888
+
+/* Linear pixel index -> pixel addressing over an image's buffer, for any of the formats above. Only packed images
+ * (i.e. without padding at the end of each scan line) are supported so that a pixel's address is always just its
+ * index scaled; anything else is repacked once up front (see standardizeImage()) rather than having every access
+ * work out the row and column.
+ *
+ * The layout is only known at runtime, which is all that the occasional access to a lone pixel or channel needs.
+ * Hot paths are instead specialized for the layout once (see withLayout()) and use the accessors that take it,
+ * which compile down to direct loads and stores.
+ */
+template<typename ByteT>
+    requires std::is_same_v<std::remove_const_t<ByteT>, uchar>
+class BasicPxGrid
+{
+//-Class Enums------------------------------------------------------------------------------------------------------
+public:
+    enum Layout { Argb32, Rgba8888, Rgb888, Bgr888 };
+
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    static constexpr bool MUTABLE = !std::is_const_v<ByteT>;
+
+//-Instance Variables------------------------------------------------------------------------------------------------------
+private:
+    ByteT* mBits;
+    Layout mLayout;
+    int mBytes;
+    std::array<int, CH_COUNT> mOffsets;
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    BasicPxGrid() :
+        mBits(nullptr),
+        mLayout(Argb32),
+        mBytes(Argb32Layout::BYTES),
+        mOffsets(Argb32Layout::OFFSETS)
+    {}
+
+    BasicPxGrid(ByteT* bits, int width, qsizetype bytesPerLine, QImage::Format format) :
+        mBits(bits),
+        mLayout(layoutOf(format)),
+        mBytes(withLayout(mLayout, []<typename L>(L){ return L::BYTES; })),
+        mOffsets(withLayout(mLayout, []<typename L>(L){ return L::OFFSETS; }))
+    {
+        Q_ASSERT(supports(format));
+        Q_ASSERT(bytesPerLine == width * mBytes);
+        Q_UNUSED(width);
+        Q_UNUSED(bytesPerLine);
+    }
+
+//-Class Functions----------------------------------------------------------------------------------------------
+private:
+    static Layout layoutOf(QImage::Format format)
+    {
+        switch(format)
+        {
+            case QImage::Format_RGBA8888:
+            case QImage::Format_RGBX8888:
+                return Rgba8888;
+            case QImage::Format_RGB888:
+                return Rgb888;
+            case QImage::Format_BGR888:
+                return Bgr888;
+            default:
+                return Argb32;
+        }
+    }
+
+public:
+    static bool supports(QImage::Format format)
+    {
+        switch(format)
+        {
+            case QImage::Format_ARGB32:
+            case QImage::Format_RGB32:
+            case QImage::Format_RGBA8888:
+            case QImage::Format_RGBX8888:
+            case QImage::Format_RGB888:
+            case QImage::Format_BGR888:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    static bool isPacked(const QImage& image) { return image.bytesPerLine() * 8 == static_cast<qsizetype>(image.width()) * image.depth(); }
+
+    template<typename F>
+    static decltype(auto) withLayout(Layout layout, F f)
+    {
+        // Calls 'f' with an instance of the PxLayout matching 'layout'
+        switch(layout)
+        {
+            case Rgba8888:
+                return f(Rgba8888Layout{});
+            case Rgb888:
+                return f(Rgb888Layout{});
+            case Bgr888:
+                return f(Bgr888Layout{});
+            default:
+                return f(Argb32Layout{});
+        }
+    }
+
+    static BasicPxGrid of(QImage& image) requires MUTABLE
+    {
+        return BasicPxGrid(image.bits(), image.width(), image.bytesPerLine(), image.format());
+    }
+
+    static BasicPxGrid of(const QImage& image) requires (!MUTABLE)
+    {
+        return BasicPxGrid(image.constBits(), image.width(), image.bytesPerLine(), image.format());
+    }
+
+//-Instance Functions----------------------------------------------------------------------------------------------
+private:
+    ByteT* address(qint64 index) const { return mBits + index * mBytes; }
+
+public:
+    bool isNull() const { return !mBits; }
+    Layout layout() const { return mLayout; }
+
+    QRgb load(qint64 index) const
+    {
+        const uchar* px = address(index);
+        QRgb a = mOffsets[Channel::Alpha] >= 0 ? px[mOffsets[Channel::Alpha]] : 0xFF;
+        return (a << 24) | (QRgb(px[mOffsets[Channel::Red]]) << 16) | (QRgb(px[mOffsets[Channel::Green]]) << 8) |
+               QRgb(px[mOffsets[Channel::Blue]]);
+    }
+
+    template<typename L>
+    QRgb load(qint64 index) const
+    {
+        Q_ASSERT(L::OFFSETS == mOffsets);
+        return L::load(mBits + index * L::BYTES);
+    }
+
+    void prefetch(qint64 index) const
+    {
+        // Only a hint, so compilers without a way to give one simply skip it
+        const uchar* px = address(index);
+#if defined(Q_CC_GNU) || defined(Q_CC_CLANG)
+        __builtin_prefetch(px);
+#elif defined(Q_CC_MSVC) && defined(Q_PROCESSOR_X86)
+        _mm_prefetch(reinterpret_cast<const char*>(px), _MM_HINT_T0);
+#else
+        Q_UNUSED(px);
+#endif
+    }
+
+    void store(qint64 index, QRgb value) const requires MUTABLE
+    {
+        uchar* px = address(index);
+        if(mOffsets[Channel::Alpha] >= 0)
+            px[mOffsets[Channel::Alpha]] = qAlpha(value);
+        px[mOffsets[Channel::Red]] = qRed(value);
+        px[mOffsets[Channel::Green]] = qGreen(value);
+        px[mOffsets[Channel::Blue]] = qBlue(value);
+    }
+
+    template<typename L>
+    void store(qint64 index, QRgb value) const requires MUTABLE
+    {
+        Q_ASSERT(L::OFFSETS == mOffsets);
+        L::store(mBits + index * L::BYTES, value);
+    }
+
+    ByteT* channel(qint64 index, Channel ch) const
+    {
+        Q_ASSERT(mOffsets[ch] >= 0);
+        return address(index) + mOffsets[ch];
+    }
+};
+
+using PxGrid = BasicPxGrid<uchar>;
+using ConstPxGrid = BasicPxGrid<const uchar>;
+
+}
+
+#endif // PX_GRID_H
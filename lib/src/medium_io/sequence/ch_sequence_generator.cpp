@@ -1,8 +1,9 @@
 // Unit Include
 #include "ch_sequence_generator.h"
 
-// Qx Includes
-#include <qx/core/qx-integrity.h>
+// Project Includes
+#include "integrity/crc32.h"
+#include "medium_io/sequence/fast_rng.h"
 
 namespace PxCryptPrivate
 {
@@ -12,56 +13,185 @@ namespace PxCryptPrivate
 //===============================================================================================================
 
 //-Constructor---------------------------------------------------------------------------------------------------------
+//Private:
+ChSequenceGenerator::ChSequenceGenerator(quint32 seed, Ordering ordering) :
+    mSeed(seed),
+    mOrdering(ordering),
+    mGenerator(seed),
+    mPermutation(0),
+    mTaken(0),
+    mPixel(0),
+    mCheckpoints(std::make_shared<Checkpoints>())
+{
+    if(usesCheckpoints())
+        recordCheckpoint();
+    choosePermutation();
+}
+
 //Public:
-ChSequenceGenerator::ChSequenceGenerator(QByteArrayView seed) :
-    mGenerator(Qx::Integrity::crc32(seed)),
-    mUnusedChannels(ALL_CHANNELS.cbegin(), ALL_CHANNELS.cend())
+ChSequenceGenerator::ChSequenceGenerator(QByteArrayView seed, Ordering ordering) :
+    ChSequenceGenerator(Crc32::compute(seed), ordering)
 {
     Q_ASSERT(!seed.isEmpty());
 }
 
 ChSequenceGenerator::ChSequenceGenerator(const State& state) :
+    mSeed(state.seed()),
+    mOrdering(state.ordering()),
     mGenerator(state.rng()),
-    mUnusedChannels(state.channels())
+    mPermutation(state.permutation()),
+    mTaken(state.taken()),
+    mPixel(state.pixel()),
+    mCheckpoints(state.checkpoints())
 {}
 
+//-Class Functions----------------------------------------------------------------------------------------------
+//Private:
+quint8 ChSequenceGenerator::drawPermutation(QRandomGenerator& generator, Ordering ordering)
+{
+    /* Drawn ordering picks the first channel out of three and the second out of the remaining two, exactly as
+     * the original format did so that its images stay decodable; the picks map straight onto the table's layout.
+     * Those picks went through the 64-bit overload of bounded(), which rejects and redraws values that fall out
+     * of range, so the generator advances by a varying amount per pixel.
+     *
+     * Tabled ordering covers all six orders with a single pick through the 32-bit overload instead, which always
+     * consumes exactly one value.
+     */
+    if(ordering == Ordering::Drawn)
+    {
+        qint64 first = generator.bounded(qint64(3));
+        qint64 second = generator.bounded(qint64(2));
+        return (first * 2) + second;
+    }
+    else
+        return generator.bounded(quint32(PERMUTATIONS.size()));
+}
+
+quint8 ChSequenceGenerator::keyedPermutation(quint32 seed, quint64 pixel)
+{
+    // Scaled the same way as the 32-bit overload of QRandomGenerator::bounded()
+    quint64 value = SplitMix64::at(seed, pixel) >> 32;
+    return (value * PERMUTATIONS.size()) >> 32;
+}
+
+void ChSequenceGenerator::skipPixels(QRandomGenerator& generator, Ordering ordering, quint64 count)
+{
+    // Only a fixed number of values per pixel can be skipped without looking at them
+    if(ordering == Ordering::Tabled)
+        generator.discard(count);
+    else
+    {
+        for(quint64 i = 0; i < count; i++)
+            drawPermutation(generator, ordering);
+    }
+}
+
 //-Instance Functions--------------------------------------------------------------------------------------------
 //Private:
-void ChSequenceGenerator::reset()
+bool ChSequenceGenerator::usesCheckpoints() const { return mOrdering != Ordering::Keyed; }
+
+void ChSequenceGenerator::choosePermutation()
+{
+    mPermutation = mOrdering == Ordering::Keyed ? keyedPermutation(mSeed, mPixel) : drawPermutation(mGenerator, mOrdering);
+}
+
+void ChSequenceGenerator::beginPixel()
+{
+    mPixel++;
+    mTaken = 0;
+
+    if(usesCheckpoints() && mPixel % CHECKPOINT_INTERVAL == 0)
+        recordCheckpoint();
+
+    choosePermutation();
+}
+
+void ChSequenceGenerator::recordCheckpoint()
+{
+    // Only record if this is the next checkpoint needed; the table is shared so another instance may have done it already
+    Q_ASSERT(mPixel % CHECKPOINT_INTERVAL == 0 && mTaken == 0);
+    if(mPixel / CHECKPOINT_INTERVAL == mCheckpoints->size())
+        mCheckpoints->push_back(mGenerator);
+}
+
+void ChSequenceGenerator::extendCheckpoints(quint64 index)
 {
-    mUnusedChannels.append(ALL_CHANNELS.data(), ALL_CHANNELS.size());
+    Checkpoints& cps = *mCheckpoints;
+    while(cps.size() <= index)
+    {
+        QRandomGenerator cp = cps.back();
+        skipPixels(cp, mOrdering, CHECKPOINT_INTERVAL);
+        cps.push_back(cp);
+    }
 }
 
 //Public:
-bool ChSequenceGenerator::pixelExhausted() const { return mUnusedChannels.isEmpty(); }
+ChSequenceGenerator::Ordering ChSequenceGenerator::ordering() const { return mOrdering; }
+bool ChSequenceGenerator::pixelExhausted() const { return mTaken == 3; }
 
 ChSequenceGenerator::State ChSequenceGenerator::state() const
 {
-    return State{mGenerator, mUnusedChannels};
+    return State{mSeed, mOrdering, mGenerator, mPermutation, mTaken, mPixel, mCheckpoints};
+}
+
+std::unique_ptr<ChSequenceGenerator> ChSequenceGenerator::reordered(Ordering ordering) const
+{
+    // Starts over from the same seed, since sequences with a different ordering have nothing in common
+    return std::unique_ptr<ChSequenceGenerator>(new ChSequenceGenerator(mSeed, ordering));
 }
 
 Channel ChSequenceGenerator::next()
 {
-    // Reset if on new pixel
+    // The whole order of a pixel is drawn when it's reached, so this only needs to step through it
     if(pixelExhausted())
-        reset();
+        beginPixel();
+
+    return PERMUTATIONS[mPermutation][mTaken++];
+}
 
-    // Determine next channel
-    auto rem = mUnusedChannels.size();
-    quint32 idx = rem == 1 ? 0 : mGenerator.bounded(rem);
-    Channel ch = mUnusedChannels[idx];
+Channel ChSequenceGenerator::seek(quint64 pixel, int channel)
+{
+    /* The generator state at the start of any pixel is the nearest preceding checkpoint advanced past the pixels
+     * in between, which is a plain discard for Tabled ordering but requires replaying them for Drawn ordering.
+     * Checkpoints that don't exist yet are filled in along the way so that later seeks in the same region are cheap.
+     * Keyed ordering has no generator state to restore at all.
+     */
+    Q_ASSERT(channel >= 0 && channel < 3);
+
+    if(usesCheckpoints())
+    {
+        quint64 cpIdx = pixel / CHECKPOINT_INTERVAL;
+        extendCheckpoints(cpIdx);
+
+        mGenerator = (*mCheckpoints)[cpIdx];
+        skipPixels(mGenerator, mOrdering, pixel % CHECKPOINT_INTERVAL);
+    }
+
+    mPixel = pixel;
+    choosePermutation();
+    mTaken = channel + 1;
+
+    return PERMUTATIONS[mPermutation][channel];
+}
 
-    // Update state and return
-    mUnusedChannels.remove(idx);
-    return ch;
+void ChSequenceGenerator::prepare(quint64 pixel)
+{
+    /* Record every checkpoint up to and including the one following 'pixel' so that instances sharing the
+     * table never need to add to it (see recordCheckpoint()) while at or before that pixel, which allows them
+     * to be used concurrently.
+     */
+    if(usesCheckpoints())
+        extendCheckpoints(pixel / CHECKPOINT_INTERVAL + 1);
 }
 
 //-Operators----------------------------------------------------------------------------------------------------------------
 //Public:
 bool ChSequenceGenerator::operator==(const State& state) const
 {
-    return mGenerator == state.rng() &&
-           mUnusedChannels == state.channels();
+    // Generators sharing a checkpoint table share a seed and ordering, so the position alone identifies the state
+    return mCheckpoints == state.checkpoints() &&
+           mPixel == state.pixel() &&
+           mTaken == state.taken();
 }
 
 //===============================================================================================================
@@ -70,14 +200,25 @@ bool ChSequenceGenerator::operator==(const State& state) const
 
 //-Constructor---------------------------------------------------------------------------------------------------------
 //Public:
-ChSequenceGenerator::State::State(const QRandomGenerator& rng, const ChannelTracker& channels) :
+ChSequenceGenerator::State::State(quint32 seed, Ordering ordering, const QRandomGenerator& rng, quint8 permutation,
+                                  int taken, quint64 pixel, const std::shared_ptr<Checkpoints>& checkpoints) :
+    mSeed(seed),
+    mOrdering(ordering),
     mRng(rng),
-    mChannels(channels)
+    mPermutation(permutation),
+    mTaken(taken),
+    mPixel(pixel),
+    mCheckpoints(checkpoints)
 {}
 
 //-Instance Functions--------------------------------------------------------------------------------------------
 //Public:
+quint32 ChSequenceGenerator::State::seed() const { return mSeed; }
+ChSequenceGenerator::Ordering ChSequenceGenerator::State::ordering() const { return mOrdering; }
 QRandomGenerator ChSequenceGenerator::State::rng() const { return mRng; }
-ChSequenceGenerator::ChannelTracker ChSequenceGenerator::State::channels() const { return mChannels; }
+quint8 ChSequenceGenerator::State::permutation() const { return mPermutation; }
+int ChSequenceGenerator::State::taken() const { return mTaken; }
+quint64 ChSequenceGenerator::State::pixel() const { return mPixel; }
+std::shared_ptr<ChSequenceGenerator::Checkpoints> ChSequenceGenerator::State::checkpoints() const { return mCheckpoints; }
 
 }
@@ -3,10 +3,11 @@
 
 // Standard Library Includes
 #include <array>
+#include <memory>
+#include <vector>
 
 // Qt Includes
 #include <QRandomGenerator>
-#include <QVarLengthArray>
 
 // Project Includes
 #include "codec/encdec.h"
@@ -18,7 +19,17 @@ class ChSequenceGenerator
 {
 //-Aliases----------------------------------------------------------------------------------------------------------
 private:
-    using ChannelTracker = QVarLengthArray<Channel, 3>;
+    using Order = std::array<Channel, 3>;
+    using Checkpoints = std::vector<QRandomGenerator>;
+
+//-Class Enums------------------------------------------------------------------------------------------------------
+public:
+    enum class Ordering : quint8
+    {
+        Drawn, // A variable length draw per channel choice (two per pixel, the last channel is implied)
+        Tabled, // A single fixed length draw per pixel, indexing PERMUTATIONS directly
+        Keyed // Like Tabled, but each pixel's draw is derived from the seed and pixel alone, so no generator state is needed
+    };
 
 //-Inner Class------------------------------------------------------------------------------------------------------
 public:
@@ -26,27 +37,63 @@ public:
 
 //-Class Variables------------------------------------------------------------------------------------------------------
 private:
-    static constexpr std::array<Channel, 3> ALL_CHANNELS{Channel::Red, Channel::Green, Channel::Blue};
+    /* Every order the channels of a pixel can be visited in. These are arranged such that the index of the order
+     * produced by Drawn ordering's picks (the first from all three channels, the second from the remaining two,
+     * in RGB order) is simply (first * 2) + second.
+     */
+    static constexpr std::array<Order, 6> PERMUTATIONS{{
+        {Channel::Red, Channel::Green, Channel::Blue},
+        {Channel::Red, Channel::Blue, Channel::Green},
+        {Channel::Green, Channel::Red, Channel::Blue},
+        {Channel::Green, Channel::Blue, Channel::Red},
+        {Channel::Blue, Channel::Red, Channel::Green},
+        {Channel::Blue, Channel::Green, Channel::Red}
+    }};
+
+    // Generator state is recorded every this many pixels so that any pixel can be reached with bounded effort
+    static constexpr quint64 CHECKPOINT_INTERVAL = 4096;
 
 //-Instance Variables------------------------------------------------------------------------------------------------------
 private:
+    quint32 mSeed;
+    Ordering mOrdering;
     QRandomGenerator mGenerator;
-    ChannelTracker mUnusedChannels;
+    quint8 mPermutation;
+    int mTaken;
+    quint64 mPixel;
+    std::shared_ptr<Checkpoints> mCheckpoints;
 
 //-Constructor---------------------------------------------------------------------------------------------------------
+private:
+    ChSequenceGenerator(quint32 seed, Ordering ordering);
+
 public:
-    ChSequenceGenerator(QByteArrayView seed);
+    ChSequenceGenerator(QByteArrayView seed, Ordering ordering = Ordering::Drawn);
     ChSequenceGenerator(const State& state);
 
+//-Class Functions----------------------------------------------------------------------------------------------
+private:
+    static quint8 drawPermutation(QRandomGenerator& generator, Ordering ordering);
+    static quint8 keyedPermutation(quint32 seed, quint64 pixel);
+    static void skipPixels(QRandomGenerator& generator, Ordering ordering, quint64 count);
+
 //-Instance Functions----------------------------------------------------------------------------------------------
 private:
-    void reset();
+    bool usesCheckpoints() const;
+    void choosePermutation();
+    void beginPixel();
+    void recordCheckpoint();
+    void extendCheckpoints(quint64 index);
 
 public:
+    Ordering ordering() const;
     bool pixelExhausted() const;
     State state() const;
+    std::unique_ptr<ChSequenceGenerator> reordered(Ordering ordering) const;
 
     Channel next();
+    Channel seek(quint64 pixel, int channel);
+    void prepare(quint64 pixel);
 
 //-Operators----------------------------------------------------------------------------------------------------------------
 public:
@@ -57,17 +104,28 @@ class ChSequenceGenerator::State
 {
 //-Instance Variables------------------------------------------------------------------------------------------------------
 private:
+    quint32 mSeed;
+    Ordering mOrdering;
     QRandomGenerator mRng;
-    ChannelTracker mChannels;
+    quint8 mPermutation;
+    int mTaken;
+    quint64 mPixel;
+    std::shared_ptr<Checkpoints> mCheckpoints;
 
 //-Constructor-------------------------------------------------------------------------------------------------------------
 public:
-    State(const QRandomGenerator& rng, const ChannelTracker& channels);
+    State(quint32 seed, Ordering ordering, const QRandomGenerator& rng, quint8 permutation, int taken, quint64 pixel,
+          const std::shared_ptr<Checkpoints>& checkpoints);
 
 //-Instance Functions------------------------------------------------------------------------------------------------------
 public:
+    quint32 seed() const;
+    Ordering ordering() const;
     QRandomGenerator rng() const;
-    ChannelTracker channels() const;
+    quint8 permutation() const;
+    int taken() const;
+    quint64 pixel() const;
+    std::shared_ptr<Checkpoints> checkpoints() const;
 };
 
 }
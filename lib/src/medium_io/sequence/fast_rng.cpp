@@ -0,0 +1,104 @@
+// Unit Include
+#include "fast_rng.h"
+
+// Standard Library Includes
+#include <algorithm>
+#include <bit>
+
+// Qt Includes
+#include <QCryptographicHash>
+#include <QtEndian>
+
+namespace PxCryptPrivate
+{
+
+//===============================================================================================================
+// SplitMix64
+//===============================================================================================================
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+SplitMix64::SplitMix64(quint64 seed) : mState(seed) {}
+
+//-Class Functions----------------------------------------------------------------------------------------------
+//Public:
+quint64 SplitMix64::mix(quint64 z)
+{
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+quint64 SplitMix64::at(quint64 seed, quint64 index)
+{
+    // The state only ever advances by a constant, so any output can be produced directly
+    return mix(seed + (index + 1) * GAMMA);
+}
+
+//-Instance Functions--------------------------------------------------------------------------------------------
+//Public:
+quint64 SplitMix64::generate64()
+{
+    mState += GAMMA;
+    return mix(mState);
+}
+
+//===============================================================================================================
+// Xoshiro256ss
+//===============================================================================================================
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+Xoshiro256ss::Xoshiro256ss(QByteArrayView seed)
+{
+    /* The state is loaded straight from a SHA-256 digest of the seed so that none of the seed's entropy is lost
+     * and the state can't be worked back to it. The generator is stuck at zero if its state is all zeros, so
+     * in the unlikely case that the digest is, the state is instead expanded from it with SplitMix64 as
+     * recommended by the generator's authors.
+     */
+    Q_ASSERT(!seed.isEmpty());
+    QByteArray digest = QCryptographicHash::hash(seed, QCryptographicHash::Sha256);
+    Q_ASSERT(digest.size() == sizeof(mState));
+    for(std::size_t i = 0; i < mState.size(); i++)
+        mState[i] = qFromLittleEndian<quint64>(digest.constData() + (i * sizeof(quint64)));
+
+    if(std::all_of(mState.cbegin(), mState.cend(), [](quint64 s){ return s == 0; }))
+    {
+        SplitMix64 expander(0);
+        for(quint64& s : mState)
+            s = expander.generate64();
+    }
+}
+
+//-Instance Functions--------------------------------------------------------------------------------------------
+//Public:
+quint64 Xoshiro256ss::generate64()
+{
+    const quint64 result = std::rotl(mState[1] * 5, 7) * 9;
+    const quint64 t = mState[1] << 17;
+
+    mState[2] ^= mState[0];
+    mState[3] ^= mState[1];
+    mState[1] ^= mState[2];
+    mState[0] ^= mState[3];
+    mState[2] ^= t;
+    mState[3] = std::rotl(mState[3], 45);
+
+    return result;
+}
+
+quint64 Xoshiro256ss::bounded(quint64 highest)
+{
+    // Value in [0, highest), using the same masked rejection as QRandomGenerator so that it's unbiased
+    Q_ASSERT(highest > 0);
+    const quint64 mask = highest > 1 ? ~0ULL >> std::countl_zero(highest - 1) : 0;
+
+    quint64 v;
+    do
+        v = generate64() & mask;
+    while(v >= highest);
+
+    return v;
+}
+
+}
@@ -0,0 +1,55 @@
+#ifndef FAST_RNG_H
+#define FAST_RNG_H
+
+// Standard Library Includes
+#include <array>
+
+// Qt Includes
+#include <QByteArrayView>
+
+namespace PxCryptPrivate
+{
+
+class SplitMix64
+{
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    static constexpr quint64 GAMMA = 0x9E3779B97F4A7C15;
+
+//-Instance Variables------------------------------------------------------------------------------------------------------
+private:
+    quint64 mState;
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    explicit SplitMix64(quint64 seed);
+
+//-Class Functions----------------------------------------------------------------------------------------------
+public:
+    static quint64 mix(quint64 z);
+    static quint64 at(quint64 seed, quint64 index);
+
+//-Instance Functions----------------------------------------------------------------------------------------------
+public:
+    quint64 generate64();
+};
+
+class Xoshiro256ss
+{
+//-Instance Variables------------------------------------------------------------------------------------------------------
+private:
+    std::array<quint64, 4> mState;
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    explicit Xoshiro256ss(QByteArrayView seed);
+
+//-Instance Functions----------------------------------------------------------------------------------------------
+public:
+    quint64 generate64();
+    quint64 bounded(quint64 highest);
+};
+
+}
+
+#endif // FAST_RNG_H
@@ -0,0 +1,123 @@
+// Unit Include
+#include "px_block_shuffle.h"
+
+// Standard Library Includes
+#include <algorithm>
+
+// Project Includes
+#include "medium_io/sequence/fast_rng.h"
+
+namespace PxCryptPrivate
+{
+
+//===============================================================================================================
+// PxBlockShuffle
+//===============================================================================================================
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+PxBlockShuffle::PxBlockShuffle(quint64 domain, QByteArrayView seed) :
+    mDomain(domain),
+    mBlocks(domain / BLOCK_PIXELS),
+    mTail(domain % BLOCK_PIXELS),
+    mBlockOrder(std::max<quint64>(mBlocks, 1), seed), // Never used without whole blocks
+    mInnerSeed(SplitMix64::mix(Xoshiro256ss(seed).generate64() ^ INNER_TWEAK))
+{
+    Q_ASSERT(domain > 0);
+}
+
+//-Class Functions----------------------------------------------------------------------------------------------
+//Private:
+quint64 PxBlockShuffle::inverse(quint64 odd)
+{
+    // Multiplicative inverse modulo 2^64 by Newton's method, each step doubles the number of correct low bits
+    Q_ASSERT(odd & 1);
+    quint64 inv = odd; // Correct to 3 bits
+    for(int i = 0; i < 5; ++i)
+        inv *= 2 - odd * inv;
+
+    return inv;
+}
+
+//-Instance Functions--------------------------------------------------------------------------------------------
+//Private:
+PxBlockShuffle::InnerKey PxBlockShuffle::innerKey(quint64 block) const
+{
+    quint64 k = SplitMix64::at(mInnerSeed, block);
+    return {
+        .mul1 = (k & BLOCK_MASK) | 1,
+        .add = (k >> BLOCK_BITS) & BLOCK_MASK,
+        .mul2 = ((k >> (BLOCK_BITS * 2)) & BLOCK_MASK) | 1
+    };
+}
+
+quint64 PxBlockShuffle::scramble(const InnerKey& key, quint64 offset) const
+{
+    /* Odd multipliers and xorshifts are all bijections modulo the block size, so chaining them shuffles the
+     * offsets within a block for the cost of a few instructions.
+     */
+    quint64 o = (offset * key.mul1 + key.add) & BLOCK_MASK;
+    o ^= o >> HALF_BITS;
+    return (o * key.mul2) & BLOCK_MASK;
+}
+
+quint64 PxBlockShuffle::unscramble(const InnerKey& key, quint64 offset) const
+{
+    quint64 o = (offset * inverse(key.mul2)) & BLOCK_MASK;
+    o ^= o >> HALF_BITS; // Self-inverse since it shifts by at least half of the width
+    return ((o - key.add) * inverse(key.mul1)) & BLOCK_MASK;
+}
+
+quint64 PxBlockShuffle::mapInner(quint64 block, quint64 offset, quint64 size) const
+{
+    // Cycle walking keeps the partial block's offsets within it, as with PxPermutation::map()
+    InnerKey key = innerKey(block);
+    quint64 o = scramble(key, offset);
+    while(o >= size)
+        o = scramble(key, o);
+
+    return o;
+}
+
+quint64 PxBlockShuffle::unmapInner(quint64 block, quint64 offset, quint64 size) const
+{
+    InnerKey key = innerKey(block);
+    quint64 o = unscramble(key, offset);
+    while(o >= size)
+        o = unscramble(key, o);
+
+    return o;
+}
+
+//Public:
+quint64 PxBlockShuffle::domain() const { return mDomain; }
+
+quint64 PxBlockShuffle::map(quint64 index) const
+{
+    /* Consecutive runs of BLOCK_PIXELS indices map to a whole block of contiguous pixels, with the blocks
+     * themselves placed by a keyed permutation and the pixels within each shuffled cheaply, so that the
+     * pixels of a run share cache lines and pages while the runs are still spread across the whole image.
+     * The partial block at the end of the image, if any, is always visited last.
+     */
+    Q_ASSERT(index < mDomain);
+    quint64 block = index >> BLOCK_BITS;
+    quint64 offset = index & BLOCK_MASK;
+    if(block == mBlocks)
+        return (mBlocks << BLOCK_BITS) + mapInner(mBlocks, offset, mTail);
+
+    quint64 placed = mBlockOrder.map(block);
+    return (placed << BLOCK_BITS) + mapInner(placed, offset, BLOCK_PIXELS);
+}
+
+quint64 PxBlockShuffle::unmap(quint64 value) const
+{
+    Q_ASSERT(value < mDomain);
+    quint64 block = value >> BLOCK_BITS;
+    quint64 offset = value & BLOCK_MASK;
+    if(block == mBlocks)
+        return (mBlocks << BLOCK_BITS) + unmapInner(mBlocks, offset, mTail);
+
+    return (mBlockOrder.unmap(block) << BLOCK_BITS) + unmapInner(block, offset, BLOCK_PIXELS);
+}
+
+}
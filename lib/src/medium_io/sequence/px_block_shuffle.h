@@ -0,0 +1,66 @@
+#ifndef PX_BLOCK_SHUFFLE_H
+#define PX_BLOCK_SHUFFLE_H
+
+// Qt Includes
+#include <QByteArrayView>
+
+// Project Includes
+#include "medium_io/sequence/px_permutation.h"
+
+namespace PxCryptPrivate
+{
+
+class PxBlockShuffle
+{
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    static constexpr int BLOCK_BITS = 8;
+    static constexpr int HALF_BITS = BLOCK_BITS / 2;
+    static constexpr quint64 BLOCK_MASK = (1ULL << BLOCK_BITS) - 1;
+    static constexpr quint64 INNER_TWEAK = 0x626C6F636B73; // "blocks", keeps the inner keys apart from those of the block order
+
+public:
+    static constexpr quint64 BLOCK_PIXELS = 1ULL << BLOCK_BITS;
+
+//-Inner Struct-----------------------------------------------------------------------------------------------------------
+private:
+    struct InnerKey
+    {
+        quint64 mul1;
+        quint64 add;
+        quint64 mul2;
+    };
+
+//-Instance Variables------------------------------------------------------------------------------------------------------
+private:
+    quint64 mDomain;
+    quint64 mBlocks; // Whole blocks only, any remainder is a partial block that's always last
+    quint64 mTail;
+    PxPermutation mBlockOrder;
+    quint64 mInnerSeed;
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    PxBlockShuffle(quint64 domain, QByteArrayView seed);
+
+//-Class Functions----------------------------------------------------------------------------------------------
+private:
+    static quint64 inverse(quint64 odd);
+
+//-Instance Functions----------------------------------------------------------------------------------------------
+private:
+    InnerKey innerKey(quint64 block) const;
+    quint64 scramble(const InnerKey& key, quint64 offset) const;
+    quint64 unscramble(const InnerKey& key, quint64 offset) const;
+    quint64 mapInner(quint64 block, quint64 offset, quint64 size) const;
+    quint64 unmapInner(quint64 block, quint64 offset, quint64 size) const;
+
+public:
+    quint64 domain() const;
+    quint64 map(quint64 index) const;
+    quint64 unmap(quint64 value) const;
+};
+
+}
+
+#endif // PX_BLOCK_SHUFFLE_H
@@ -0,0 +1,110 @@
+// Unit Include
+#include "px_permutation.h"
+
+// Standard Library Includes
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+// Project Includes
+#include "medium_io/sequence/fast_rng.h"
+
+namespace PxCryptPrivate
+{
+
+//===============================================================================================================
+// PxPermutation
+//===============================================================================================================
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+PxPermutation::PxPermutation(quint64 domain, QByteArrayView seed) :
+    mDomain(domain)
+{
+    /* The network works on blocks of just enough bits to hold every index in the domain, so less than half of
+     * the block values fall outside of it and need to be walked past. Odd widths are split into halves that
+     * differ by a bit, which trade places every round.
+     */
+    Q_ASSERT(domain > 0);
+    int bits = std::max(2, static_cast<int>(std::bit_width(domain - 1)));
+    mLeftBits = (bits + 1) / 2;
+    mRightBits = bits / 2;
+
+    // Keyed from the seed's digest, which is what the generator's state is loaded from
+    Xoshiro256ss keyGen(seed);
+    for(quint64& k : mKeys)
+        k = keyGen.generate64();
+}
+
+//-Class Functions----------------------------------------------------------------------------------------------
+//Private:
+quint64 PxPermutation::lowMask(int bits) { return (1ULL << bits) - 1; }
+
+//-Instance Functions--------------------------------------------------------------------------------------------
+//Private:
+quint64 PxPermutation::round(int r, quint64 half) const { return SplitMix64::mix(mKeys[r] ^ half); }
+
+quint64 PxPermutation::encrypt(quint64 block) const
+{
+    // Each round the right half becomes the left, and the left, mixed with the right, becomes the new right
+    int leftBits = mLeftBits;
+    int rightBits = mRightBits;
+    quint64 left = block >> rightBits;
+    quint64 right = block & lowMask(rightBits);
+    for(int r = 0; r < ROUNDS; ++r)
+    {
+        quint64 next = (left ^ round(r, right)) & lowMask(leftBits);
+        left = right;
+        right = next;
+        std::swap(leftBits, rightBits);
+    }
+
+    // The halves are back to their original widths as there is an even number of rounds
+    return (left << rightBits) | right;
+}
+
+quint64 PxPermutation::decrypt(quint64 block) const
+{
+    int leftBits = mLeftBits;
+    int rightBits = mRightBits;
+    quint64 left = block >> rightBits;
+    quint64 right = block & lowMask(rightBits);
+    for(int r = ROUNDS - 1; r >= 0; --r)
+    {
+        quint64 prev = (right ^ round(r, left)) & lowMask(rightBits);
+        right = left;
+        left = prev;
+        std::swap(leftBits, rightBits);
+    }
+
+    return (left << rightBits) | right;
+}
+
+//Public:
+quint64 PxPermutation::domain() const { return mDomain; }
+
+quint64 PxPermutation::map(quint64 index) const
+{
+    /* Cycle walking: the network permutes the whole block range, so values outside of the domain are fed
+     * back in until one lands inside it. Since the walk follows the network's own cycles, the result is
+     * still a bijection over the domain.
+     */
+    Q_ASSERT(index < mDomain);
+    quint64 value = encrypt(index);
+    while(value >= mDomain)
+        value = encrypt(value);
+
+    return value;
+}
+
+quint64 PxPermutation::unmap(quint64 value) const
+{
+    Q_ASSERT(value < mDomain);
+    quint64 index = decrypt(value);
+    while(index >= mDomain)
+        index = decrypt(index);
+
+    return index;
+}
+
+}
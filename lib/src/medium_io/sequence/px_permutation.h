@@ -0,0 +1,48 @@
+#ifndef PX_PERMUTATION_H
+#define PX_PERMUTATION_H
+
+// Standard Library Includes
+#include <array>
+
+// Qt Includes
+#include <QByteArrayView>
+
+namespace PxCryptPrivate
+{
+
+class PxPermutation
+{
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    static constexpr int ROUNDS = 6; // Must be even, see encrypt()
+
+//-Instance Variables------------------------------------------------------------------------------------------------------
+private:
+    quint64 mDomain;
+    int mLeftBits;
+    int mRightBits; // Either equal to mLeftBits or one less
+    std::array<quint64, ROUNDS> mKeys;
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    PxPermutation(quint64 domain, QByteArrayView seed);
+
+//-Class Functions----------------------------------------------------------------------------------------------
+private:
+    static quint64 lowMask(int bits);
+
+//-Instance Functions----------------------------------------------------------------------------------------------
+private:
+    quint64 round(int r, quint64 half) const;
+    quint64 encrypt(quint64 block) const;
+    quint64 decrypt(quint64 block) const;
+
+public:
+    quint64 domain() const;
+    quint64 map(quint64 index) const;
+    quint64 unmap(quint64 value) const;
+};
+
+}
+
+#endif // PX_PERMUTATION_H
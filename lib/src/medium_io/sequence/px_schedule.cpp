@@ -0,0 +1,221 @@
+// Unit Include
+#include "px_schedule.h"
+
+// Standard Library Includes
+#include <algorithm>
+#include <random>
+
+namespace PxCryptPrivate
+{
+
+namespace
+{
+
+template<typename T>
+void placeIn(std::vector<std::unique_ptr<T[]>>& blocks, quint64 block, quint64 offset, quint64 index, quint64 blockSize)
+{
+    std::unique_ptr<T[]>& b = blocks[block];
+    if(!b)
+        b = std::make_unique_for_overwrite<T[]>(blockSize);
+    b[offset] = static_cast<T>(index);
+}
+
+}
+
+//===============================================================================================================
+// PxSchedule
+//===============================================================================================================
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Private:
+PxSchedule::PxSchedule(quint64 total, const QByteArray& seed, Engine engine) :
+    mSeed(seed),
+    mEngine(engine),
+    mGenerator(createGenerator(total, seed, engine)),
+    mTracker(isComputed(engine) ? 0 : total), // Permutations never revisit a pixel
+    mTotal(total),
+    mWide(mTotal > std::numeric_limits<quint32>::max()),
+    mMaterialized(0)
+{
+    Q_ASSERT(!seed.isEmpty());
+    Q_ASSERT(mTotal > 0);
+
+    // Only the block table is allocated up front, the blocks themselves are allocated as they're reached
+    quint64 blocks = (mTotal + EXTENSION_BLOCK - 1) / EXTENSION_BLOCK;
+    if(mWide)
+        mWideOrder.resize(blocks);
+    else
+        mOrder.resize(blocks);
+}
+
+//Public:
+PxSchedule::PxSchedule(const QSize& dim, const QByteArray& seed, Engine engine) :
+    PxSchedule(static_cast<quint64>(dim.width()) * static_cast<quint64>(dim.height()), seed, engine)
+{}
+
+//-Class Functions----------------------------------------------------------------------------------------------
+//Private:
+PxSchedule::Generator PxSchedule::createGenerator(quint64 total, const QByteArray& seed, Engine engine)
+{
+    switch(engine)
+    {
+        case Engine::Mersenne:
+        {
+            std::seed_seq ss(seed.cbegin(), seed.cend());
+            return QRandomGenerator(ss);
+        }
+        case Engine::Xoshiro:
+            return Xoshiro256ss(seed);
+        case Engine::Feistel:
+            return PxPermutation(total, seed);
+        case Engine::Blocked:
+            return PxBlockShuffle(total, seed);
+    }
+
+    Q_UNREACHABLE();
+}
+
+bool PxSchedule::isComputed(Engine engine) { return engine == Engine::Feistel || engine == Engine::Blocked; }
+
+//-Instance Functions--------------------------------------------------------------------------------------------
+//Private:
+void PxSchedule::place(quint64 position, quint64 index)
+{
+    quint64 block = position / EXTENSION_BLOCK;
+    quint64 offset = position % EXTENSION_BLOCK;
+    if(mWide)
+        placeIn(mWideOrder, block, offset, index, EXTENSION_BLOCK);
+    else
+        placeIn(mOrder, block, offset, index, EXTENSION_BLOCK);
+}
+
+quint64 PxSchedule::load(quint64 position) const
+{
+    quint64 block = position / EXTENSION_BLOCK;
+    quint64 offset = position % EXTENSION_BLOCK;
+    return mWide ? mWideOrder[block][offset] : mOrder[block][offset];
+}
+
+void PxSchedule::retain(quint64 index)
+{
+    // Only done while the schedule is being created, before it can be shared
+    place(mMaterialized, index);
+    mMaterialized++;
+
+    // A permutation can't be told which pixels are taken, so their positions in it are skipped over instead
+    if(isComputed(mEngine))
+    {
+        quint64 permIdx = unmapIndex(index);
+        mSkipped.insert(std::upper_bound(mSkipped.begin(), mSkipped.end(), permIdx), permIdx);
+    }
+    else
+        mTracker.reserve(index);
+}
+
+template<typename Rng>
+void PxSchedule::extend(Rng& generator, quint64 count)
+{
+    /* Separate instantiations per engine keep the draw inlined into the loop; the engine is only looked
+     * at once per extension, not per pixel. The new positions are only published once they're all written.
+     */
+    quint64 i = mMaterialized.load(std::memory_order_relaxed);
+    for(; i < count; ++i)
+    {
+        // Mersenne must draw exactly as the tracker based generator did (i.e. bounded(max + 1))
+        quint64 naturalIdx = generator.bounded(mTotal);
+        quint64 actualIdx = mTracker.reserveNearestFree(naturalIdx);
+        place(i, actualIdx);
+    }
+
+    mMaterialized.store(i, std::memory_order_release);
+}
+
+quint64 PxSchedule::mapIndex(quint64 index) const
+{
+    return mEngine == Engine::Feistel ? std::get<PxPermutation>(mGenerator).map(index) :
+                                        std::get<PxBlockShuffle>(mGenerator).map(index);
+}
+
+quint64 PxSchedule::unmapIndex(quint64 value) const
+{
+    return mEngine == Engine::Feistel ? std::get<PxPermutation>(mGenerator).unmap(value) :
+                                        std::get<PxBlockShuffle>(mGenerator).unmap(value);
+}
+
+quint64 PxSchedule::permuted(quint64 position) const
+{
+    /* Positions past the retained pixels map to the permutation's indices with those of the retained pixels
+     * removed, so each skipped index at or before the one reached so far pushes it up by one.
+     */
+    quint64 permIdx = position - materialized();
+    for(quint64 s : mSkipped)
+        if(s <= permIdx)
+            ++permIdx;
+
+    return mapIndex(permIdx);
+}
+
+//Public:
+const QByteArray& PxSchedule::seed() const { return mSeed; }
+PxSchedule::Engine PxSchedule::engine() const { return mEngine; }
+quint64 PxSchedule::total() const { return mTotal; }
+quint64 PxSchedule::materialized() const { return mMaterialized.load(std::memory_order_acquire); }
+bool PxSchedule::isComplete() const { return materialized() == mTotal; }
+
+void PxSchedule::materialize(quint64 count)
+{
+    // Positions of computed schedules are computed on demand
+    count = std::min(count, mTotal);
+    if(isComputed(mEngine) || count <= materialized())
+        return;
+
+    // Whoever gets the lock first extends the schedule, anyone else waiting likely finds there's nothing left to do
+    QMutexLocker locker(&mExtensionMutex);
+    switch(mEngine)
+    {
+        case Engine::Mersenne:
+            extend(std::get<QRandomGenerator>(mGenerator), count);
+            break;
+        case Engine::Xoshiro:
+            extend(std::get<Xoshiro256ss>(mGenerator), count);
+            break;
+        case Engine::Feistel:
+        case Engine::Blocked:
+            Q_UNREACHABLE();
+    }
+}
+
+void PxSchedule::materializeAll() { materialize(mTotal); }
+
+quint64 PxSchedule::at(quint64 position)
+{
+    Q_ASSERT(position < mTotal);
+
+    if(isComputed(mEngine) && position >= materialized())
+        return permuted(position);
+
+    if(position >= materialized()) [[unlikely]]
+        materialize(std::max(position + 1, materialized() + EXTENSION_BLOCK));
+
+    return load(position);
+}
+
+std::shared_ptr<PxSchedule> PxSchedule::rebased(Engine engine, quint64 keep)
+{
+    /* Produces a schedule from the same seed that visits the first 'keep' pixels of this one in the same order
+     * (i.e. the meta pixels, which are always located using the original engine), with the remainder drawn
+     * by 'engine' from the pixels that are left. The kept pixels are always the first draws of the original
+     * engine, so going back to it just means starting over.
+     */
+    Q_ASSERT(keep <= mTotal);
+    std::shared_ptr<PxSchedule> schedule(new PxSchedule(mTotal, mSeed, engine));
+    if(engine == Engine::Mersenne)
+        return schedule;
+
+    for(quint64 i = 0; i < keep; ++i)
+        schedule->retain(at(i));
+
+    return schedule;
+}
+
+}
@@ -0,0 +1,103 @@
+#ifndef PX_SCHEDULE_H
+#define PX_SCHEDULE_H
+
+// Standard Library Includes
+#include <atomic>
+#include <memory>
+#include <variant>
+#include <vector>
+
+// Qt Includes
+#include <QMutex>
+#include <QRandomGenerator>
+#include <QSize>
+
+// Project Includes
+#include "medium_io/sequence/fast_rng.h"
+#include "medium_io/sequence/px_block_shuffle.h"
+#include "medium_io/sequence/px_permutation.h"
+#include "medium_io/sequence/px_tracker.h"
+
+namespace PxCryptPrivate
+{
+
+class PxSchedule
+{
+//-Class Enums------------------------------------------------------------------------------------------------------
+public:
+    enum class Engine : quint8
+    {
+        Mersenne, // QRandomGenerator (MT19937) seeded with the whole seed, as the original format did
+        Xoshiro, // Xoshiro256**, far smaller and faster
+        Feistel, // A keyed bijection over all pixels, computed per position so nothing is drawn or stored
+        Blocked // Like Feistel, but over blocks of contiguous pixels that are each visited in one go
+    };
+
+//-Aliases----------------------------------------------------------------------------------------------------------
+private:
+    using Generator = std::variant<QRandomGenerator, Xoshiro256ss, PxPermutation, PxBlockShuffle>;
+    template<typename T>
+    using Blocks = std::vector<std::unique_ptr<T[]>>;
+
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    static constexpr quint64 EXTENSION_BLOCK = 4096; // Pixels per block of the visit order, and the minimum materialized per extension
+
+//-Instance Variables------------------------------------------------------------------------------------------------------
+private:
+    // Generation (guarded by mExtensionMutex once shared)
+    QMutex mExtensionMutex;
+    QByteArray mSeed;
+    Engine mEngine;
+    Generator mGenerator;
+    PxTracker mTracker; // Empty for computed engines
+    std::vector<quint64> mSkipped; // Sorted permutation indices of retained pixels (computed engines only)
+    quint64 mTotal;
+
+    /* Visit order, stored in blocks that never move once allocated so that it can be read without locking
+     * up to mMaterialized while another thread extends it.
+     */
+    bool mWide;
+    Blocks<quint32> mOrder;
+    Blocks<quint64> mWideOrder; // Only used if pixel count exceeds 32-bit range
+    std::atomic<quint64> mMaterialized;
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+private:
+    PxSchedule(quint64 total, const QByteArray& seed, Engine engine);
+
+public:
+    PxSchedule(const QSize& dim, const QByteArray& seed, Engine engine = Engine::Mersenne);
+
+//-Class Functions----------------------------------------------------------------------------------------------
+private:
+    static Generator createGenerator(quint64 total, const QByteArray& seed, Engine engine);
+    static bool isComputed(Engine engine);
+
+//-Instance Functions----------------------------------------------------------------------------------------------
+private:
+    void place(quint64 position, quint64 index);
+    quint64 load(quint64 position) const;
+    void retain(quint64 index);
+    template<typename Rng>
+    void extend(Rng& generator, quint64 count);
+    quint64 mapIndex(quint64 index) const;
+    quint64 unmapIndex(quint64 value) const;
+    quint64 permuted(quint64 position) const;
+
+public:
+    const QByteArray& seed() const;
+    Engine engine() const;
+    quint64 total() const;
+    quint64 materialized() const;
+    bool isComplete() const;
+
+    void materialize(quint64 count);
+    void materializeAll();
+    quint64 at(quint64 position);
+    std::shared_ptr<PxSchedule> rebased(Engine engine, quint64 keep);
+};
+
+}
+
+#endif // PX_SCHEDULE_H
@@ -0,0 +1,91 @@
+// Unit Include
+#include "px_schedule_cache.h"
+
+// Standard Library Includes
+#include <algorithm>
+#include <optional>
+
+namespace PxCryptPrivate
+{
+
+//===============================================================================================================
+// PxScheduleCache
+//===============================================================================================================
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+PxScheduleCache::PxScheduleCache() :
+    mSize(0),
+    mCreations(0)
+{}
+
+//-Instance Functions--------------------------------------------------------------------------------------------
+//Public:
+std::shared_ptr<PxSchedule> PxScheduleCache::obtain(const Key& key, const std::function<std::shared_ptr<PxSchedule>()>& create)
+{
+    /* Schedules only depend on the pixel count, seed and engine, so mediums that share those (e.g. the parts of
+     * a multi-part encoding, which are usually the same size) share one schedule and the pixels materialized
+     * by any of them are free for the rest. Schedules are safe to extend from multiple threads at once.
+     *
+     * The lock only covers the bookkeeping. The first to ask for a schedule creates it afterwards, while anyone
+     * else asking for the same one in the meantime waits on just that, so unrelated mediums never wait on each
+     * other.
+     */
+    std::promise<std::shared_ptr<PxSchedule>> promise;
+    std::optional<quint64> creation; // Set if cached
+    {
+        QMutexLocker locker(&mMutex);
+
+        // There are only ever a handful of entries, so a linear search is fine
+        auto itr = std::find_if(mEntries.begin(), mEntries.end(), [&key](const Entry& e){ return e.key == key; });
+        if(itr != mEntries.end())
+        {
+            mEntries.splice(mEntries.begin(), mEntries, itr);
+            std::shared_future<std::shared_ptr<PxSchedule>> pending = itr->schedule;
+            locker.unlock();
+            return pending.get();
+        }
+
+        if(key.total <= CAPACITY)
+        {
+            // Evict least recently used, which only drops the cache's reference; mediums using them keep them alive
+            while(mSize + key.total > CAPACITY)
+            {
+                mSize -= mEntries.back().key.total;
+                mEntries.pop_back();
+            }
+
+            creation = mCreations++;
+            mEntries.push_front({key, promise.get_future().share(), *creation});
+            mSize += key.total;
+        }
+    }
+
+    std::shared_ptr<PxSchedule> schedule;
+    try
+    {
+        schedule = create();
+    }
+    catch(...)
+    {
+        // Don't leave a dead entry behind, and pass the actual failure on to anyone already waiting on it
+        if(creation)
+        {
+            QMutexLocker locker(&mMutex);
+            auto itr = std::find_if(mEntries.begin(), mEntries.end(), [&creation](const Entry& e){ return e.creation == *creation; });
+            if(itr != mEntries.end())
+            {
+                mSize -= itr->key.total;
+                mEntries.erase(itr);
+            }
+        }
+
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    promise.set_value(schedule);
+    return schedule;
+}
+
+}
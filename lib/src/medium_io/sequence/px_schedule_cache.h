@@ -0,0 +1,69 @@
+#ifndef PX_SCHEDULE_CACHE_H
+#define PX_SCHEDULE_CACHE_H
+
+// Standard Library Includes
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+
+// Qt Includes
+#include <QByteArray>
+#include <QMutex>
+
+// Project Includes
+#include "medium_io/sequence/px_schedule.h"
+
+namespace PxCryptPrivate
+{
+
+/* Shares schedules between the mediums of one multi-part encode or decode, which is the only time more than one
+ * canvas with the same seed exists at once. It lives only as long as that operation, so neither the schedules
+ * nor the key material they are derived from outlive it.
+ */
+class PxScheduleCache
+{
+//-Inner Struct-----------------------------------------------------------------------------------------------------------
+public:
+    struct Key
+    {
+        quint64 total;
+        QByteArray seed;
+        PxSchedule::Engine engine;
+        quint64 retained; // Pixels carried over from the original engine's schedule
+
+        bool operator==(const Key& other) const = default;
+    };
+
+private:
+    struct Entry
+    {
+        Key key;
+        std::shared_future<std::shared_ptr<PxSchedule>> schedule; // Ready once whoever first asked for it has created it
+        quint64 creation; // Identifies the obtain() call that created it, as the key may be evicted and reused meanwhile
+    };
+
+//-Class Variables------------------------------------------------------------------------------------------------------
+private:
+    // Total pixels across all cached schedules, which keeps a full cache around 130MB at most, even if fully materialized
+    static constexpr quint64 CAPACITY = 32 * 1024 * 1024;
+
+//-Instance Variables------------------------------------------------------------------------------------------------------
+private:
+    QMutex mMutex;
+    std::list<Entry> mEntries; // Most recently used first
+    quint64 mSize;
+    quint64 mCreations;
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    PxScheduleCache();
+
+//-Instance Functions----------------------------------------------------------------------------------------------
+public:
+    std::shared_ptr<PxSchedule> obtain(const Key& key, const std::function<std::shared_ptr<PxSchedule>()>& create);
+};
+
+}
+
+#endif // PX_SCHEDULE_CACHE_H
@@ -1,51 +1,78 @@
 // Unit Include
 #include "px_sequence_generator.h"
 
+// Project Includes
+#include "medium_io/sequence/px_schedule_cache.h"
+
 namespace PxCryptPrivate
 {
 
+namespace
+{
+
+std::shared_ptr<PxSchedule> obtainSchedule(PxScheduleCache* cache, const PxScheduleCache::Key& key,
+                                           const std::function<std::shared_ptr<PxSchedule>()>& create)
+{
+    return cache ? cache->obtain(key, create) : create();
+}
+
+}
+
 //===============================================================================================================
 // PxSequenceGenerator
 //===============================================================================================================
 
 //-Constructor---------------------------------------------------------------------------------------------------------
 //Public:
-PxSequenceGenerator::PxSequenceGenerator(const QSize& dim, const QByteArray& seed) :
-    mSeed(seed),
-    mPixelTracker(0, (dim.width() * dim.height()) - 1),
+PxSequenceGenerator::PxSequenceGenerator(const QSize& dim, const QByteArray& seed, PxSchedule::Engine engine, PxScheduleCache* cache) :
+    mSchedule(obtainSchedule(cache, {static_cast<quint64>(dim.width()) * static_cast<quint64>(dim.height()), seed, engine, 0},
+                             [&]{ return std::make_shared<PxSchedule>(dim, seed, engine); })),
+    mCache(cache),
+    mPosition(0),
     mAtEnd(false)
 {
-    Q_ASSERT(!seed.isEmpty());
-    Q_ASSERT(!dim.isEmpty());
-
-    // Seed generator
-    std::seed_seq ss(seed.cbegin(), seed.cend());
-    mGenerator.seed(ss);
+    fillAhead();
 }
 
 PxSequenceGenerator::PxSequenceGenerator(const State& state) :
-    mPixelTracker(state.start(), state.end())
+    mSchedule(state.schedule()), // Shared, so the visit order up to the state's coverage is already known
+    mCache(state.cache()),
+    mPosition(state.coverage()),
+    mAtEnd(state.atEnd())
 {
-    // Seed generator
-    std::seed_seq ss(state.seed().cbegin(), state.seed().cend());
-    mGenerator.seed(ss);
+    fillAhead();
+}
 
-    // Advance generator to reach state coverage
-    while(mPixelTracker.reserved() < state.coverage())
-        next();
+//-Instance Functions--------------------------------------------------------------------------------------------
+//Private:
+qint64 PxSequenceGenerator::lookup(quint64 position) const
+{
+    return position < mSchedule->total() ? static_cast<qint64>(mSchedule->at(position)) : -1;
+}
 
-    // Set at end flag
-    mAtEnd = state.atEnd();
+void PxSequenceGenerator::fillAhead()
+{
+    for(quint64 p = mPosition; p < mPosition + LOOKAHEAD; ++p)
+        mAhead[p % LOOKAHEAD] = lookup(p);
 }
 
-//-Instance Functions--------------------------------------------------------------------------------------------
 //Public:
-quint64 PxSequenceGenerator::pixelCoverage() const { return mPixelTracker.reserved(); }
-quint64 PxSequenceGenerator::pixelTotal() const { return mPixelTracker.range(); }
+PxSchedule::Engine PxSequenceGenerator::engine() const { return mSchedule->engine(); }
+quint64 PxSequenceGenerator::pixelCoverage() const { return mPosition; }
+quint64 PxSequenceGenerator::pixelTotal() const { return mSchedule->total(); }
 
 PxSequenceGenerator::State PxSequenceGenerator::state() const
 {
-    return State{mSeed, mPixelTracker.minimum(), mPixelTracker.maximum(), mPixelTracker.reserved(), mAtEnd};
+    return State{mSchedule, mCache, mPosition, mAtEnd};
+}
+
+std::unique_ptr<PxSequenceGenerator> PxSequenceGenerator::rebased(PxSchedule::Engine engine, quint64 keep) const
+{
+    // The position is kept as is, so the sequence only diverges from this one once past 'keep'
+    quint64 retained = engine == PxSchedule::Engine::Mersenne ? 0 : keep; // Rebasing onto the original engine is a fresh schedule
+    auto schedule = obtainSchedule(mCache, {mSchedule->total(), mSchedule->seed(), engine, retained},
+                                   [&]{ return mSchedule->rebased(engine, keep); });
+    return std::make_unique<PxSequenceGenerator>(State{schedule, mCache, mPosition, mAtEnd});
 }
 
 qint64 PxSequenceGenerator::next()
@@ -57,18 +84,42 @@ qint64 PxSequenceGenerator::next()
     }
 
     // Handle going to end case
-    if(mPixelTracker.isBooked())
+    if(mPosition == mSchedule->total())
     {
         mAtEnd = true;
         return -1;
     }
 
-    // Determine next index
-    quint64 naturalIdx = mGenerator.bounded(mPixelTracker.maximum() + 1);
-    std::optional<quint64> actualIdx = mPixelTracker.reserveNearestFree(naturalIdx);
-    Q_ASSERT(actualIdx.has_value());
+    /* Pixels are pulled from the schedule LOOKAHEAD positions early so that callers can see where the
+     * sequence is headed (e.g. to prefetch) without looking anything up twice.
+     */
+    qint64& slot = mAhead[mPosition % LOOKAHEAD];
+    qint64 px = slot;
+    slot = lookup(mPosition + LOOKAHEAD);
+    ++mPosition;
+    return px;
+}
 
-    return static_cast<qint64>(actualIdx.value());
+qint64 PxSequenceGenerator::peek(quint64 ahead) const
+{
+    // The pixel that will be returned by next() after 'ahead' other calls, or -1 if that's past the end
+    Q_ASSERT(ahead < LOOKAHEAD);
+    return mAhead[(mPosition + ahead) % LOOKAHEAD];
+}
+
+void PxSequenceGenerator::seek(quint64 position)
+{
+    // The schedule is random-access, so any position can be jumped to directly; next() yields the pixel at 'position'
+    Q_ASSERT(position <= mSchedule->total());
+    mPosition = position;
+    mAtEnd = false;
+    fillAhead();
+}
+
+void PxSequenceGenerator::prepare(quint64 position)
+{
+    // Materialize the shared schedule through 'position' (and the lookahead beyond it) up front, so that instances sharing it only read from it
+    mSchedule->materialize(position + 1 + LOOKAHEAD);
 }
 
 bool PxSequenceGenerator::atEnd() const { return mAtEnd; }
@@ -77,10 +128,8 @@ bool PxSequenceGenerator::atEnd() const { return mAtEnd; }
 //Public:
 bool PxSequenceGenerator::operator==(const State& state) const
 {
-    return mSeed == state.seed() &&
-           mPixelTracker.minimum() == state.start() &&
-           mPixelTracker.maximum() == state.end() &&
-           mPixelTracker.reserved() == state.coverage();
+    return mSchedule == state.schedule() &&
+           mPosition == state.coverage();
 }
 
 //===============================================================================================================
@@ -89,19 +138,17 @@ bool PxSequenceGenerator::operator==(const State& state) const
 
 //-Constructor---------------------------------------------------------------------------------------------------------
 //Public:
-PxSequenceGenerator::State::State(const QByteArray& seed, quint64 start, quint64 end, quint64 coverage, bool atEnd) :
-    mSeed(seed),
-    mStart(start),
-    mEnd(end),
+PxSequenceGenerator::State::State(const std::shared_ptr<PxSchedule>& schedule, PxScheduleCache* cache, quint64 coverage, bool atEnd) :
+    mSchedule(schedule),
+    mCache(cache),
     mCoverage(coverage),
     mAtEnd(atEnd)
 {}
 
 //-Instance Functions--------------------------------------------------------------------------------------------
 //Public:
-QByteArray PxSequenceGenerator::State::seed() const { return mSeed; }
-quint64 PxSequenceGenerator::State::start() const { return mStart; }
-quint64 PxSequenceGenerator::State::end() const { return mEnd; }
+std::shared_ptr<PxSchedule> PxSequenceGenerator::State::schedule() const { return mSchedule; }
+PxScheduleCache* PxSequenceGenerator::State::cache() const { return mCache; }
 quint64 PxSequenceGenerator::State::coverage() const { return mCoverage; }
 bool PxSequenceGenerator::State::atEnd() const { return mAtEnd; }
 
@@ -1,42 +1,62 @@
 #ifndef PX_SEQUENCE_GENERATOR_H
 #define PX_SEQUENCE_GENERATOR_H
 
+// Standard Library Includes
+#include <array>
+#include <memory>
+
 // Qt Includes
-#include <QRandomGenerator>
 #include <QSize>
 #include <QPoint>
 
-// Qx Includes
-#include <qx/core/qx-freeindextracker.h>
+// Project Includes
+#include "medium_io/sequence/px_schedule.h"
 
 namespace PxCryptPrivate
 {
 
+class PxScheduleCache;
+
 class PxSequenceGenerator
 {
 //-Inner Class------------------------------------------------------------------------------------------------------
 public:
     class State;
 
+//-Class Variables------------------------------------------------------------------------------------------------------
+public:
+    static constexpr quint64 LOOKAHEAD = 16; // Upcoming pixels known ahead of next(), must be a power of 2
+
 //-Instance Variables------------------------------------------------------------------------------------------------------
 private:
-    QByteArray mSeed;
-    QRandomGenerator mGenerator;
-    Qx::FreeIndexTracker mPixelTracker;
+    std::shared_ptr<PxSchedule> mSchedule;
+    PxScheduleCache* mCache; // Optional, shared with other generators for the same operation
+    quint64 mPosition;
     bool mAtEnd;
+    std::array<qint64, LOOKAHEAD> mAhead; // Ring of the pixels at mPosition onward, -1 past the end
 
 //-Constructor---------------------------------------------------------------------------------------------------------
 public:
-    PxSequenceGenerator(const QSize& dim, const QByteArray& seed);
+    PxSequenceGenerator(const QSize& dim, const QByteArray& seed, PxSchedule::Engine engine = PxSchedule::Engine::Mersenne,
+                        PxScheduleCache* cache = nullptr);
     PxSequenceGenerator(const State& state);
 
 //-Instance Functions----------------------------------------------------------------------------------------------
+private:
+    qint64 lookup(quint64 position) const;
+    void fillAhead();
+
 public:
+    PxSchedule::Engine engine() const;
     quint64 pixelCoverage() const;
     quint64 pixelTotal() const;
     State state() const;
+    std::unique_ptr<PxSequenceGenerator> rebased(PxSchedule::Engine engine, quint64 keep) const;
 
     qint64 next();
+    qint64 peek(quint64 ahead) const;
+    void seek(quint64 position);
+    void prepare(quint64 position);
     bool atEnd() const;
 
 //-Operators----------------------------------------------------------------------------------------------------------------
@@ -48,21 +68,19 @@ class PxSequenceGenerator::State
 {
 //-Instance Variables------------------------------------------------------------------------------------------------------
 private:
-    QByteArray mSeed;
-    quint64 mStart;
-    quint64 mEnd;
+    std::shared_ptr<PxSchedule> mSchedule;
+    PxScheduleCache* mCache;
     quint64 mCoverage;
     bool mAtEnd;
 
 //-Constructor-------------------------------------------------------------------------------------------------------------
 public:
-    State(const QByteArray& seed, quint64 start, quint64 end, quint64 coverage, bool atEnd);
+    State(const std::shared_ptr<PxSchedule>& schedule, PxScheduleCache* cache, quint64 coverage, bool atEnd);
 
 //-Instance Functions------------------------------------------------------------------------------------------------------
 public:
-    QByteArray seed() const;
-    quint64 start() const;
-    quint64 end() const;
+    std::shared_ptr<PxSchedule> schedule() const;
+    PxScheduleCache* cache() const;
     quint64 coverage() const;
     bool atEnd() const;
 };
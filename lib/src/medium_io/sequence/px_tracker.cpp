@@ -0,0 +1,162 @@
+// Unit Include
+#include "px_tracker.h"
+
+// Standard Library Includes
+#include <bit>
+
+namespace PxCryptPrivate
+{
+
+namespace
+{
+
+quint64 lowMaskInclusive(int bit) { return bit == 63 ? ~0ULL : (1ULL << (bit + 1)) - 1; }
+
+}
+
+//===============================================================================================================
+// PxTracker
+//===============================================================================================================
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+//Public:
+PxTracker::PxTracker(quint64 total) :
+    mTotal(total)
+{
+    // An empty tracker takes no memory at all, for when nothing needs tracking
+    quint64 bits = mTotal;
+    while(bits > 0)
+    {
+        quint64 words = (bits + 63) / 64;
+        std::vector<quint64>& level = mLevels.emplace_back(words, 0);
+        if(int pad = bits % 64; pad != 0)
+            level.back() = ~lowMaskInclusive(pad - 1);
+
+        if(words == 1)
+            break;
+        bits = words;
+    }
+}
+
+//-Instance Functions--------------------------------------------------------------------------------------------
+//Private:
+std::optional<quint64> PxTracker::firstFreeFrom(quint64 index) const
+{
+    /* Climbs until a word with a free bit at or after the position is found, moving just past the current word
+     * with each level (since the rest of it is known to be full), then descends through the first free bit of
+     * each word below, so at most two words per level are looked at.
+     */
+    if(index >= mTotal)
+        return std::nullopt;
+
+    quint64 pos = index;
+    size_t lvl = 0;
+    for(;; ++lvl)
+    {
+        if(lvl == mLevels.size())
+            return std::nullopt;
+
+        const std::vector<quint64>& level = mLevels[lvl];
+        quint64 w = pos >> 6;
+        if(w >= level.size())
+            return std::nullopt;
+
+        if(quint64 bits = ~level[w] & (~0ULL << (pos & 63)); bits)
+        {
+            pos = (w << 6) + std::countr_zero(bits);
+            break;
+        }
+
+        pos = w + 1;
+    }
+
+    while(lvl > 0)
+    {
+        --lvl;
+        pos = (pos << 6) + std::countr_zero(~mLevels[lvl][pos]);
+    }
+
+    return pos;
+}
+
+std::optional<quint64> PxTracker::lastFreeUpTo(quint64 index) const
+{
+    // Mirror of firstFreeFrom()
+    Q_ASSERT(index < mTotal);
+
+    quint64 pos = index;
+    size_t lvl = 0;
+    for(;; ++lvl)
+    {
+        if(lvl == mLevels.size())
+            return std::nullopt;
+
+        quint64 w = pos >> 6;
+        if(quint64 bits = ~mLevels[lvl][w] & lowMaskInclusive(pos & 63); bits)
+        {
+            pos = (w << 6) + (63 - std::countl_zero(bits));
+            break;
+        }
+
+        if(w == 0)
+            return std::nullopt;
+
+        pos = w - 1;
+    }
+
+    while(lvl > 0)
+    {
+        --lvl;
+        pos = (pos << 6) + (63 - std::countl_zero(~mLevels[lvl][pos]));
+    }
+
+    return pos;
+}
+
+//Public:
+quint64 PxTracker::total() const { return mTotal; }
+bool PxTracker::isFree(quint64 index) const { return !(mLevels.front()[index >> 6] & (1ULL << (index & 63))); }
+
+quint64 PxTracker::nearestFree(quint64 index) const
+{
+    /* Equivalent to Qx::FreeIndexTracker::reserveNearestFree(), which originally defined the sequence: the
+     * index itself if free, otherwise the closest free index on either side, with the lower index winning
+     * ties.
+     */
+    Q_ASSERT(index < mTotal);
+    if(isFree(index))
+        return index;
+
+    std::optional<quint64> prev = index > 0 ? lastFreeUpTo(index - 1) : std::nullopt;
+    std::optional<quint64> next = firstFreeFrom(index + 1);
+    Q_ASSERT(prev || next); // Otherwise every index is already reserved
+
+    if(prev && (!next || (index - *prev) <= (*next - index)))
+        return *prev;
+    else
+        return *next;
+}
+
+void PxTracker::reserve(quint64 index)
+{
+    // Filling a word marks it as full in the level above, which may in turn fill that word, and so on
+    quint64 pos = index;
+    for(std::vector<quint64>& level : mLevels)
+    {
+        quint64& word = level[pos >> 6];
+        word |= 1ULL << (pos & 63);
+        if(word != ~0ULL)
+            break;
+
+        pos >>= 6;
+    }
+}
+
+quint64 PxTracker::reserveNearestFree(quint64 index)
+{
+    quint64 free = nearestFree(index);
+    reserve(free);
+    return free;
+}
+
+}
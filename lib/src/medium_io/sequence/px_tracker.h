@@ -0,0 +1,45 @@
+#ifndef PX_TRACKER_H
+#define PX_TRACKER_H
+
+// Standard Library Includes
+#include <optional>
+#include <vector>
+
+// Qt Includes
+#include <QtGlobal>
+
+namespace PxCryptPrivate
+{
+
+class PxTracker
+{
+//-Instance Variables------------------------------------------------------------------------------------------------------
+private:
+    quint64 mTotal;
+
+    /* Level 0 has 1 bit per pixel, set when reserved. Every level above has 1 bit per word of the level below,
+     * set when that word is full, up to a level of a single word. Padding bits are always set.
+     */
+    std::vector<std::vector<quint64>> mLevels;
+
+//-Constructor---------------------------------------------------------------------------------------------------------
+public:
+    explicit PxTracker(quint64 total);
+
+//-Instance Functions----------------------------------------------------------------------------------------------
+private:
+    std::optional<quint64> firstFreeFrom(quint64 index) const;
+    std::optional<quint64> lastFreeUpTo(quint64 index) const;
+
+public:
+    quint64 total() const;
+    bool isFree(quint64 index) const;
+    quint64 nearestFree(quint64 index) const;
+
+    void reserve(quint64 index);
+    quint64 reserveNearestFree(quint64 index);
+};
+
+}
+
+#endif // PX_TRACKER_H
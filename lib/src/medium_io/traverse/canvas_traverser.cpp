@@ -1,7 +1,11 @@
 // Unit Include
 #include "canvas_traverser.h"
 
+// Qx Includes
+#include <qx/core/qx-algorithm.h>
+
 // Project Includes
+#include "pxcrypt/codec/encoder.h"
 #include "medium_io/operate/meta_access.h"
 
 namespace PxCryptPrivate
@@ -15,26 +19,61 @@ namespace PxCryptPrivate
 //Public:
 CanvasTraverser::CanvasTraverser(MetaAccess& meta) :
     mMeta(meta),
+    mBpc(meta.bpc()),
     mLinearPosition{0, 0, 0} // Ignore meta pixels
 {
     CanvasTraverserPrime& prime = mMeta.surrenderTraverser();
     mPxSequence = prime.surrenderPxSequence();
     mChSequence = prime.surrenderChSequence();
     mCurrentSelection = Selection{prime.pixelIndex(), prime.channel()};
-
-    mInitialState = std::make_unique<State>(state());
+    mSequenceOrigin = mPxSequence->pixelCoverage() - 1; // Provisional until init(), coverage includes the current pixel
 }
 
-//-Instance Functions--------------------------------------------------------------------------------------------
+CanvasTraverser::CanvasTraverser(const CanvasTraverser& other) :
+    mMeta(other.mMeta),
+    mBpc(other.mBpc),
+    mPxSequence(std::make_unique<PxSequenceGenerator>(other.mPxSequence->state())), // Shares schedule
+    mChSequence(std::make_unique<ChSequenceGenerator>(other.mChSequence->state())), // Shares checkpoints
+    mSequenceOrigin(other.mSequenceOrigin),
+    mLinearPosition(other.mLinearPosition),
+    mCurrentSelection(other.mCurrentSelection),
+    mLinearEnd(other.mLinearEnd)
+{}
+
+//-Class Functions----------------------------------------------------------------------------------------------
 //Private:
-void CanvasTraverser::restoreState(const State& state)
+PxSchedule::Engine CanvasTraverser::pixelEngine(quint8 rev)
 {
-    mPxSequence = std::make_unique<PxSequenceGenerator>(state.pxState);
-    mChSequence = std::make_unique<ChSequenceGenerator>(state.chState);
-    mLinearPosition = state.linearPosition;
-    mCurrentSelection = state.currentSelection;
+    switch(rev)
+    {
+        case PxCrypt::Encoder::Original:
+        case PxCrypt::Encoder::ChannelTable:
+            return PxSchedule::Engine::Mersenne;
+        case PxCrypt::Encoder::FastRng:
+            return PxSchedule::Engine::Xoshiro;
+        case PxCrypt::Encoder::Permutation:
+            return PxSchedule::Engine::Feistel;
+        default:
+            return PxSchedule::Engine::Blocked;
+    }
+}
 
+ChSequenceGenerator::Ordering CanvasTraverser::channelOrdering(quint8 rev)
+{
+    // Everything after the original format picks whole channel orders at once
+    switch(rev)
+    {
+        case PxCrypt::Encoder::Original:
+            return ChSequenceGenerator::Ordering::Drawn;
+        case PxCrypt::Encoder::ChannelTable:
+            return ChSequenceGenerator::Ordering::Tabled;
+        default:
+            return ChSequenceGenerator::Ordering::Keyed;
+    }
 }
+
+//-Instance Functions--------------------------------------------------------------------------------------------
+//Private:
 void CanvasTraverser::calculateEnd()
 {
     /* Determine end Position
@@ -45,9 +84,9 @@ void CanvasTraverser::calculateEnd()
      */
 
     quint64 writeablePixels = Qx::length(mPxSequence->pixelCoverage(), mPxSequence->pixelTotal());
-    quint64 bitsAvailable = (writeablePixels * 3 * mMeta.bpc());
+    quint64 bitsAvailable = (writeablePixels * 3 * mBpc);
     bitsAvailable &= ~7; // Same as (x / 8) * 8, only count whole bytes
-    mLinearEnd = Position::fromBits(bitsAvailable, mMeta.bpc());
+    mLinearEnd = Position::fromBits(bitsAvailable, mBpc);
 }
 
 void CanvasTraverser::advanceChannel()
@@ -71,11 +110,39 @@ void CanvasTraverser::advancePixel()
     mCurrentSelection.ch = mChSequence->next();
 }
 
+void CanvasTraverser::seekPosition(const Position& pos)
+{
+    /* Both sequences advance in lock-step one pixel at a time, so the linear pixel maps directly to a
+     * sequence index that each generator can jump to without replaying those before it.
+     */
+    quint64 seqPx = mSequenceOrigin + pos.px;
+    mPxSequence->seek(seqPx);
+    mCurrentSelection.px = mPxSequence->next();
+    mCurrentSelection.ch = mChSequence->seek(seqPx, pos.ch);
+    mLinearPosition = pos;
+}
+
 //Public:
 void CanvasTraverser::init()
 {
-    if(*this != *mInitialState)
-        restoreState(*mInitialState);
+    /* The revision determines how many meta pixels precede the data and how its channels are ordered, and can be
+     * changed up until traversal starts, so rather than continuing from wherever the meta pixels were left off
+     * (which are always read using the original ordering), the sequences are positioned from scratch. The meta
+     * pixels keep their place at the start of the pixel sequence regardless of the engine used for the rest.
+     */
+    quint8 rev = mMeta.rev();
+    mSequenceOrigin = MetaAccess::metaPixelCount(rev);
+
+    PxSchedule::Engine engine = pixelEngine(rev);
+    if(mPxSequence->engine() != engine)
+        mPxSequence = mPxSequence->rebased(engine, mSequenceOrigin);
+
+    ChSequenceGenerator::Ordering ordering = channelOrdering(rev);
+    if(mChSequence->ordering() != ordering)
+        mChSequence = mChSequence->reordered(ordering);
+
+    mBpc = mMeta.bpc(); // Can't change while traversing, so avoid going through meta on every access
+    seekPosition({0, 0, 0});
     calculateEnd();
 }
 
@@ -96,9 +163,19 @@ bool CanvasTraverser::atEnd() const
 }
 
 quint64 CanvasTraverser::pixelIndex() const { return mCurrentSelection.px; }
+
+qint64 CanvasTraverser::upcomingPixelIndex(quint64 ahead) const
+{
+    // The pixel 'ahead' pixels after the current one (up to the lookahead of the sequence), or -1 if past the end
+    Q_ASSERT(ahead > 0 && ahead <= PxSequenceGenerator::LOOKAHEAD);
+    return mPxSequence->peek(ahead - 1);
+}
 Channel CanvasTraverser::channel() const { return mCurrentSelection.ch; }
 int CanvasTraverser::channelBitIndex() const { return mLinearPosition.bit; }
-int CanvasTraverser::remainingChannelBits() const { return mMeta.bpc() - channelBitIndex(); }
+int CanvasTraverser::remainingChannelBits() const { return mBpc - channelBitIndex(); }
+quint64 CanvasTraverser::bitPosition() const { return mLinearPosition.toBits(mBpc); }
+quint64 CanvasTraverser::remainingBits() const { return mLinearEnd.toBits(mBpc) - bitPosition(); }
+bool CanvasTraverser::atPixelStart() const { return mLinearPosition.ch == 0 && mLinearPosition.bit == 0; }
 
 void CanvasTraverser::advanceBits(int bitCount)
  {
@@ -109,9 +186,9 @@ void CanvasTraverser::advanceBits(int bitCount)
     }
 
     mLinearPosition.bit += bitCount;
-    Q_ASSERT(mLinearPosition.bit <= mMeta.bpc()); // Current design dictates that advancement is capped at the number of bits left on the current channel
+    Q_ASSERT(mLinearPosition.bit <= mBpc); // Current design dictates that advancement is capped at the number of bits left on the current channel
 
-    if(mLinearPosition.bit == mMeta.bpc())
+    if(mLinearPosition.bit == mBpc)
     {
         mLinearPosition.bit = 0;
         advanceChannel();
@@ -122,7 +199,7 @@ void CanvasTraverser::advanceBits(int bitCount)
 
 bool CanvasTraverser::bitAdvanceWillChangePixel(int bitCount)
 {
-    return mLinearPosition.bit + bitCount >= mMeta.bpc() && mChSequence->pixelExhausted();
+    return mLinearPosition.bit + bitCount >= mBpc && mChSequence->pixelExhausted();
 }
 
 qint64 CanvasTraverser::skip(qint64 bytes)
@@ -130,43 +207,57 @@ qint64 CanvasTraverser::skip(qint64 bytes)
     if(atEnd())
         return -1;
 
-    quint64 bitsToSkip = (static_cast<quint64>(bytes) * 8);
-    quint64 bitPos = mLinearPosition.toBits(mMeta.bpc());
-    Position newPos = Position::fromBits(bitPos + bitsToSkip, mMeta.bpc());
+    quint64 bitPos = bitPosition();
+    quint64 newBitPos = seek(bitPos + (static_cast<quint64>(bytes) * 8));
+
+    // Return actual bytes skipped
+    return (newBitPos - bitPos)/8;
+}
+
+quint64 CanvasTraverser::seek(quint64 bitPos)
+{
+    Position newPos = Position::fromBits(bitPos, mBpc);
     if(newPos > mLinearEnd)
         newPos = mLinearEnd;
 
-    /* Have to walk through each channel in order for the pixel sequence to be properly generated,
-     * but channel bit index can be set directly since we manage it here.
-     */
-    quint64 chDist = Position::channelsBeteween(mLinearPosition, newPos);
-    for(quint64 skip = 0; skip < chDist; skip++)
-        advanceChannel();
-    mLinearPosition.bit = newPos.bit;
+    // Channel bit index is managed here, so only re-select when landing on a different channel
+    if(newPos.px != mLinearPosition.px || newPos.ch != mLinearPosition.ch)
+        seekPosition(newPos);
+    else
+        mLinearPosition.bit = newPos.bit;
 
-    // Return actual bytes skipped
-    return (newPos.toBits(mMeta.bpc()) - bitPos)/8;
+    return newPos.toBits(mBpc);
 }
 
-//-Operators----------------------------------------------------------------------------------------------------------------
-//Public:
-bool CanvasTraverser::operator==(const State& state) const
+void CanvasTraverser::prepare(quint64 bitPos)
 {
-    return *mPxSequence == state.pxState &&
-           *mChSequence == state.chState &&
-           mLinearPosition == state.linearPosition &&
-           mCurrentSelection == state.currentSelection;
+    /* Copies of a traverser share their sequences' lazily built data, so before any are used concurrently this
+     * must be called with the furthest position any of them will reach. The pixel after that position's is
+     * covered as well since reaching the end of a pixel selects the next one.
+     */
+    Position pos = Position::fromBits(std::min(bitPos, mLinearEnd.toBits(mBpc)), mBpc);
+    quint64 seqPx = mSequenceOrigin + pos.px + 1;
+    mPxSequence->prepare(std::min(seqPx, mPxSequence->pixelTotal() - 1));
+    mChSequence->prepare(seqPx);
+}
+
+CanvasTraverser::PixelSelection CanvasTraverser::takePixel()
+{
+    // Consumes all channels of the current pixel at once, for callers that work on whole pixels
+    Q_ASSERT(atPixelStart() && remainingBits() >= 3u * mBpc);
+
+    PixelSelection sel{.px = mCurrentSelection.px, .channels = {mCurrentSelection.ch}};
+    sel.channels[1] = mChSequence->next();
+    sel.channels[2] = mChSequence->next();
+    advancePixel();
+
+    return sel;
 }
 
 //===============================================================================================================
 // CanvasTraverser::Position
 //===============================================================================================================
 
-quint64 CanvasTraverser::Position::channelsBeteween(const Position& a, const Position& b)
-{
-    return (b.px - a.px)*3 + (b.ch - a.ch);
-}
-
 CanvasTraverser::Position CanvasTraverser::Position::fromBits(quint64 bitPosistion, quint8 bpc)
 {
     return {
@@ -13,6 +13,13 @@ class MetaAccess;
 class CanvasTraverser
 {
 //-Inner Struct-----------------------------------------------------------------------------------------------------------
+public:
+    struct PixelSelection
+    {
+        qint64 px;
+        std::array<Channel, 3> channels; // In traversal order
+    };
+
 private:
     struct Position
     {
@@ -20,7 +27,6 @@ private:
         int ch;
         int bit;
 
-        static quint64 channelsBeteween(const Position& a, const Position& b);
         static Position fromBits(quint64 bitPos, quint8 bpc);
         quint64 toBits(quint8 bpc) const;
         bool operator==(const Position& other) const = default;
@@ -48,29 +54,34 @@ private:
 private:
     // Meta
     MetaAccess& mMeta;
+    quint8 mBpc;
 
     // Generator
     std::unique_ptr<PxSequenceGenerator> mPxSequence;
     std::unique_ptr<ChSequenceGenerator> mChSequence;
 
     // Location
+    quint64 mSequenceOrigin; // Sequence index of the first non-meta pixel
     Position mLinearPosition;
     Selection mCurrentSelection;
     Position mLinearEnd;
 
-    // State
-    std::unique_ptr<State> mInitialState;
-
 //-Constructor---------------------------------------------------------------------------------------------------------
 public:
     CanvasTraverser(MetaAccess& meta);
+    CanvasTraverser(const CanvasTraverser& other);
+
+//-Class Functions----------------------------------------------------------------------------------------------
+private:
+    static PxSchedule::Engine pixelEngine(quint8 rev);
+    static ChSequenceGenerator::Ordering channelOrdering(quint8 rev);
 
 //-Instance Functions----------------------------------------------------------------------------------------------
 private:
-    void restoreState(const State& state);
     void calculateEnd();
     void advanceChannel();
     void advancePixel();
+    void seekPosition(const Position& pos);
 
 public:
     void init();
@@ -80,18 +91,21 @@ public:
     bool atEnd() const;
 
     quint64 pixelIndex() const;
+    qint64 upcomingPixelIndex(quint64 ahead) const;
     Channel channel() const;
     int channelBitIndex() const;
     int remainingChannelBits() const;
+    quint64 bitPosition() const;
+    quint64 remainingBits() const;
+    bool atPixelStart() const;
 
     // Manipulation
     void advanceBits(int bitCount);
     bool bitAdvanceWillChangePixel(int bitCount);
     qint64 skip(qint64 bytes);
-
-//-Operators----------------------------------------------------------------------------------------------------------------
-public:
-    bool operator==(const State& state) const;
+    quint64 seek(quint64 bitPos);
+    void prepare(quint64 bitPos);
+    PixelSelection takePixel();
 };
 
 }
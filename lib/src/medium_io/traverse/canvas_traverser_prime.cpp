@@ -10,8 +10,8 @@ namespace PxCryptPrivate
 
 //-Constructor---------------------------------------------------------------------------------------------------------
 //Public:
-CanvasTraverserPrime::CanvasTraverserPrime(const QImage& image, const QByteArray& seed) :
-    mPxSequence(std::make_unique<PxSequenceGenerator>(image.size(), seed)),
+CanvasTraverserPrime::CanvasTraverserPrime(const QImage& image, const QByteArray& seed, PxScheduleCache* scheduleCache) :
+    mPxSequence(std::make_unique<PxSequenceGenerator>(image.size(), seed, PxSchedule::Engine::Mersenne, scheduleCache)),
     mChSequence(std::make_unique<ChSequenceGenerator>(seed))
 {
     Q_ASSERT(!image.isNull());
@@ -28,6 +28,7 @@ void CanvasTraverserPrime::advancePixel()
 }
 
 //Public:
+quint64 CanvasTraverserPrime::pixelTotal() const { return mPxSequence->pixelTotal(); }
 qint64 CanvasTraverserPrime::pixelIndex() const { return mCurrentIndex; }
 Channel CanvasTraverserPrime::channel() const { return mCurrentChannel; }
 
@@ -20,13 +20,14 @@ private:
 
 //-Constructor---------------------------------------------------------------------------------------------------------
 public:
-    CanvasTraverserPrime(const QImage& image, const QByteArray& seed);
+    CanvasTraverserPrime(const QImage& image, const QByteArray& seed, PxScheduleCache* scheduleCache = nullptr);
 
 //-Instance Functions----------------------------------------------------------------------------------------------
 private:
     void advancePixel();
 
 public:
+    quint64 pixelTotal() const;
     qint64 pixelIndex() const;
     Channel channel() const;
     void nextChannel();
@@ -83,13 +83,19 @@ Stat::~Stat() {}
 //-Instance Functions-------------------------------------------------------------------------------------------
 //Public:
 /*!
- *  Returns capacity information of the image, calculated at @a bpc bits-per-channel.
+ *  Returns capacity information of the image, calculated at @a bpc bits-per-channel when using format
+ *  revision @a rev.
  */
-Stat::Capacity Stat::capacity(quint8 bpc) const
+Stat::Capacity Stat::capacity(quint8 bpc, Encoder::Revision rev) const
 {
     Q_D(const Stat);
 
-    quint64 usablePixels = d->mDim.width() * d->mDim.height() - PxCryptPrivate::MetaAccess::metaPixelCount();
+    quint64 pixels = d->mDim.width() * d->mDim.height();
+    quint64 metaPixels = PxCryptPrivate::MetaAccess::metaPixelCount(rev);
+    if(pixels <= metaPixels)
+        return {.bytes = 0, .leftoverBits = 0};
+
+    quint64 usablePixels = pixels - metaPixels;
     quint64 usableChanels = usablePixels * 3;
     quint64 useableBits = usableChanels * bpc;
     quint64 useableBytes = useableBits / 8;
@@ -110,20 +116,22 @@ bool Stat::fitsMetadata() const
 }
 /*!
  *  Returns @c the smallest density (bits-per-channel) requires to store @a bytes total bytes within
- *  the image, regardless of encoder underlying storage format, or @c 0 if @a bytes exceeds the capacity
- *  of the image.
+ *  the image using format revision @a rev, regardless of encoder underlying storage format, or @c 0 if
+ *  @a bytes exceeds the capacity of the image.
  *
  *  @sa capacity().
  */
-quint8 Stat::minimumDensity(quint64 bytes) const
+quint8 Stat::minimumDensity(quint64 bytes, Encoder::Revision rev) const
 {
     Q_D(const Stat);
 
-    if(d->mDim.width() == 0 || d->mDim.height() == 0)
+    quint64 pixels = d->mDim.width() * d->mDim.height();
+    quint64 metaPixels = PxCryptPrivate::MetaAccess::metaPixelCount(rev);
+    if(pixels <= metaPixels)
         return 0;
 
     double bits = bytes * 8.0;
-    double chunks = (d->mDim.width() * d->mDim.height() - PxCryptPrivate::MetaAccess::metaPixelCount()) * 3.0;
+    double chunks = (pixels - metaPixels) * 3.0;
     double bpc = std::ceil(bits/chunks);
 
     return bpc < 8 ? bpc : 0;
@@ -0,0 +1,77 @@
+// Standard Library Includes
+#include <vector>
+
+// Qt Includes
+#include <QtTest>
+
+// Project Includes
+#include "medium_io/sequence/ch_sequence_generator.h"
+
+// Test Includes
+#include <pxcrypt_test_common.h>
+
+using namespace PxCryptPrivate;
+
+// Test
+class tst_ch_sequence_generator : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_ch_sequence_generator();
+
+private slots:
+    // Init
+//    void initTestCase();
+//    void cleanupTestCase();
+
+    // Test cases
+    void seek_matches_sequential_data();
+    void seek_matches_sequential();
+
+};
+
+tst_ch_sequence_generator::tst_ch_sequence_generator() {}
+//void tst_ch_sequence_generator::initTestCase() {}
+//void tst_ch_sequence_generator::cleanupTestCase() {}
+
+void tst_ch_sequence_generator::seek_matches_sequential_data()
+{
+    // Spans several checkpoints, so seeks land before, on, and after them
+    QTest::addColumn<QByteArray>("seed");
+    QTest::addColumn<quint64>("pixels");
+
+    // Add test rows
+    QTest::newRow("single_checkpoint") << QByteArray("seed") << quint64(1000);
+    QTest::newRow("many_checkpoints") << QByteArray("a different seed") << quint64(5 * 4096 + 123);
+}
+
+void tst_ch_sequence_generator::seek_matches_sequential()
+{
+    // Fetch data from test table
+    QFETCH(QByteArray, seed);
+    QFETCH(quint64, pixels);
+
+    // Record the full sequence
+    ChSequenceGenerator sequential(seed);
+    std::vector<Channel> expected;
+    for(quint64 i = 0; i < pixels * 3; i++)
+        expected.push_back(sequential.next());
+
+    // Seek to random positions, both forwards and backwards, with a fresh generator that has to extend the checkpoints itself
+    ChSequenceGenerator seeker(seed);
+    QRandomGenerator positions(quint32(pixels));
+    for(int i = 0; i < 2000; i++)
+    {
+        quint64 pixel = positions.bounded(pixels);
+        int channel = positions.bounded(3);
+        QCOMPARE(seeker.seek(pixel, channel), expected[pixel * 3 + channel]);
+
+        // Continuing on from a seek must follow the sequence too
+        for(quint64 j = pixel * 3 + channel + 1; j < std::min<quint64>(pixel * 3 + 8, expected.size()); j++)
+            QCOMPARE(seeker.next(), expected[j]);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_ch_sequence_generator)
+#include "tst_ch_sequence_generator.moc"
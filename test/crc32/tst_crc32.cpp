@@ -0,0 +1,154 @@
+// Standard Library Includes
+#include <algorithm>
+
+// Qt Includes
+#include <QtTest>
+
+// Qx Includes
+#include <qx/core/qx-integrity.h>
+
+// Project Includes
+#include "integrity/crc32.h"
+
+// Test Includes
+#include <pxcrypt_test_common.h>
+
+using namespace Qt::StringLiterals;
+using namespace PxCryptPrivate;
+
+// Test
+class tst_crc32 : public QObject
+{
+    Q_OBJECT
+
+private:
+    // Testing
+    QByteArray mData;
+
+public:
+    tst_crc32();
+
+private slots:
+    // Init
+    void initTestCase();
+//    void cleanupTestCase();
+
+    // Test cases
+    void kernel_matches_reference_data();
+    void kernel_matches_reference();
+    void chunked_update();
+    void combine_random_splits();
+
+};
+
+tst_crc32::tst_crc32() {}
+
+void tst_crc32::initTestCase()
+{
+    // Random, with some slack so that the largest case can start unaligned
+    QRandomGenerator rng(32);
+    mData.resize((4 * 1024 * 1024) + 64);
+    rng.fillRange(reinterpret_cast<quint32*>(mData.data()), mData.size() / sizeof(quint32));
+}
+
+//void tst_crc32::cleanupTestCase() {}
+
+void tst_crc32::kernel_matches_reference_data()
+{
+    QTest::addColumn<Crc32::Kernel>("kernel");
+
+    // Add test rows
+    QTest::newRow("sliced") << Crc32::Kernel::Sliced;
+    QTest::newRow("pclmul") << Crc32::Kernel::Pclmul;
+    QTest::newRow("armv8") << Crc32::Kernel::Armv8;
+}
+
+void tst_crc32::kernel_matches_reference()
+{
+    // Fetch data from test table
+    QFETCH(Crc32::Kernel, kernel);
+    if(!Crc32::isSupported(kernel))
+        QSKIP("Kernel is not supported by this CPU or build.");
+
+    QByteArrayView data(mData);
+
+    // Every short length, which covers each kernel's handling of leftovers and its fallback for small inputs, from every alignment
+    for(qsizetype len = 0; len <= 200; len++)
+    {
+        for(qsizetype offset = 0; offset < 16; offset++)
+        {
+            QByteArrayView chunk = data.sliced(offset, len);
+            QVERIFY2(Crc32::compute(chunk, kernel) == Qx::Integrity::crc32(chunk),
+                     C_STR(u"Mismatch for length %1 at offset %2"_s.arg(len).arg(offset)));
+        }
+    }
+
+    // Large buffers, on and off block boundaries
+    for(qsizetype len : {4095, 4096, 65536 + 7, 1024 * 1024, 4 * 1024 * 1024})
+    {
+        for(qsizetype offset : {0, 1, 7, 33})
+        {
+            QByteArrayView chunk = data.sliced(offset, len);
+            QVERIFY2(Crc32::compute(chunk, kernel) == Qx::Integrity::crc32(chunk),
+                     C_STR(u"Mismatch for length %1 at offset %2"_s.arg(len).arg(offset)));
+        }
+    }
+}
+
+void tst_crc32::chunked_update()
+{
+    // Feeding the data in pieces of random size must be the same as all at once
+    QByteArrayView data = QByteArrayView(mData).first(1024 * 1024 + 13);
+    QRandomGenerator rng(25);
+
+    for(int pass = 0; pass < 8; pass++)
+    {
+        Crc32 crc;
+        qsizetype pos = 0;
+        while(pos < data.size())
+        {
+            qsizetype len = std::min<qsizetype>(rng.bounded(pass % 2 ? 300 : 70000), data.size() - pos);
+            crc.update(data.sliced(pos, len));
+            pos += len;
+        }
+
+        QCOMPARE(crc.value(), Qx::Integrity::crc32(data));
+    }
+
+    // Reset starts over
+    Crc32 crc;
+    crc.update(data.first(100));
+    crc.reset();
+    crc.update(data);
+    QCOMPARE(crc.value(), Qx::Integrity::crc32(data));
+}
+
+void tst_crc32::combine_random_splits()
+{
+    // Joining the checksums of consecutive pieces, some possibly empty, must give the checksum of the whole
+    QRandomGenerator rng(7);
+
+    for(int pass = 0; pass < 64; pass++)
+    {
+        QByteArrayView data = QByteArrayView(mData).first(rng.bounded(1, 200000));
+        quint32 expected = Qx::Integrity::crc32(data);
+
+        int pieces = rng.bounded(1, 9);
+        QList<qsizetype> cuts{0, data.size()};
+        for(int i = 1; i < pieces; i++)
+            cuts.append(rng.bounded(data.size() + 1));
+        std::sort(cuts.begin(), cuts.end());
+
+        quint32 combined = 0; // Checksum of no data
+        for(qsizetype i = 0; i + 1 < cuts.size(); i++)
+        {
+            QByteArrayView piece = data.sliced(cuts[i], cuts[i + 1] - cuts[i]);
+            combined = Crc32::combine(combined, Crc32::compute(piece), piece.size());
+        }
+
+        QCOMPARE(combined, expected);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_crc32)
+#include "tst_crc32.moc"
@@ -28,6 +28,10 @@ private slots:
     // Test cases
     void full_data_cycle_data();
     void full_data_cycle();
+    void short_payload_source();
+    void in_place_padded_buffer();
+    void parallel_matches_sequential();
+    void memory_order_matches_traversal();
 
 };
 
@@ -44,6 +48,7 @@ void tst_encode_decode::full_data_cycle_data()
     QTest::addColumn<QByteArray>("psk");
     QTest::addColumn<quint8>("bpc");
     QTest::addColumn<PxCrypt::Encoder::Encoding>("encoding");
+    QTest::addColumn<PxCrypt::Encoder::Revision>("revision");
 
     // Helper
     struct CycleTest
@@ -54,6 +59,7 @@ void tst_encode_decode::full_data_cycle_data()
         QByteArray psk;
         quint8 bpc = 0;
         PxCrypt::Encoder::Encoding encoding;
+        PxCrypt::Encoder::Revision revision = PxCrypt::Encoder::Original;
     };
 
     auto addTestRow = [&](const CycleTest& t)
@@ -65,7 +71,7 @@ void tst_encode_decode::full_data_cycle_data()
         QByteArray payload(t.payloadSize, Qt::Uninitialized);
         std::generate(payload.begin(), payload.end(), [&rng]{ return rng.generate(); });
 
-        QTest::newRow(C_STR(t.testName)) << t.medium << t.testName << payload << t.psk << t.bpc << t.encoding;
+        QTest::newRow(C_STR(t.testName)) << t.medium << t.testName << payload << t.psk << t.bpc << t.encoding << t.revision;
     };
 
     //### Populate test table rows with each case ################################
@@ -222,6 +228,41 @@ void tst_encode_decode::full_data_cycle_data()
     addTestRow(maxTestR);
     addTestRow(maxTestA);
 
+    //-Format revision tests-----------------------------------------------------------------
+    const QList<std::pair<PxCrypt::Encoder::Revision, QString>> revisions{
+        {PxCrypt::Encoder::ChannelTable, "Channel table"},
+        {PxCrypt::Encoder::FastRng, "Fast RNG"},
+        {PxCrypt::Encoder::Permutation, "Permutation"},
+        {PxCrypt::Encoder::BlockShuffle, "Block shuffle"}
+    };
+
+    for(const auto& [rev, revStr] : revisions)
+    {
+        for(auto enc : {PxCrypt::Encoder::Absolute, PxCrypt::Encoder::Relative})
+        {
+            QString encStr = enc == PxCrypt::Encoder::Relative ? "Relative" : "Absolute";
+            CycleTest revisionTest{
+                .testName = revStr + " revision test - " + encStr,
+                .medium = realWorldImage,
+                .payloadSize = 5000,
+                .psk = QBAL("\x5A\x1B\x9C\x3D"),
+                .bpc = 2,
+                .encoding = enc,
+                .revision = rev
+            };
+
+            addTestRow(revisionTest);
+
+            // The extra meta pixel must be accounted for when filling the image completely
+            CycleTest revisionMaxTest = revisionTest;
+            revisionMaxTest.testName = revStr + " revision max capacity test - " + encStr;
+            revisionMaxTest.payloadSize = PxCrypt::StandardEncoder::calculateMaximumPayload(realWorldImage.size(), revisionMaxTest.testName.size(),
+                                                                                           7, rev);
+            revisionMaxTest.bpc = 7;
+            addTestRow(revisionMaxTest);
+        }
+    }
+
     //-Non-native format test----------------------------------------------------------------
     QImage nn(200, 200, QImage::Format_Indexed8);
     nn.fill(Qt::gray);
@@ -236,6 +277,31 @@ void tst_encode_decode::full_data_cycle_data()
     };
 
     addTestRow(nonNativeTest);
+
+    //-Directly accessed formats test--------------------------------------------------------
+    const QList<QImage::Format> directFormats{
+        QImage::Format_RGBA8888,
+        QImage::Format_RGBX8888,
+        QImage::Format_RGB888,
+        QImage::Format_BGR888
+    };
+
+    for(QImage::Format fmt : directFormats)
+    {
+        for(auto enc : {PxCrypt::Encoder::Absolute, PxCrypt::Encoder::Relative})
+        {
+            CycleTest directTest{
+                .testName = QString("Direct format test - %1 - %2").arg(int(fmt)).arg(enc == PxCrypt::Encoder::Relative ? "Relative" : "Absolute"),
+                .medium = realWorldImage.convertToFormat(fmt),
+                .payloadSize = 5000,
+                .psk = QBAL("\x0F\x1E\x2D\x3C"),
+                .bpc = 3,
+                .encoding = enc
+            };
+
+            addTestRow(directTest);
+        }
+    }
 }
 
 void tst_encode_decode::full_data_cycle()
@@ -247,12 +313,14 @@ void tst_encode_decode::full_data_cycle()
     QFETCH(QByteArray, psk);
     QFETCH(quint8, bpc);
     QFETCH(PxCrypt::Encoder::Encoding, encoding);
+    QFETCH(PxCrypt::Encoder::Revision, revision);
 
     // Encode
     PxCrypt::StandardEncoder enc;
     enc.setBpc(bpc);
     enc.setPresharedKey(psk);
     enc.setEncoding(encoding);
+    enc.setRevision(revision);
     enc.setTag(tag.toUtf8());
 
     QImage encoded;
@@ -270,6 +338,157 @@ void tst_encode_decode::full_data_cycle()
     // Compare
     QCOMPARE(decoded, payload);
     QCOMPARE(dec.tag(), tag);
+
+    // Decode again, streaming to a device
+    QByteArray streamed;
+    QBuffer sink(&streamed);
+    sink.open(QIODevice::WriteOnly);
+    dErr = dec.decode(sink, encoded, medium);
+    QVERIFY2(!dErr, C_STR(dErr.errorString()));
+    QCOMPARE(streamed, payload);
+}
+
+void tst_encode_decode::short_payload_source()
+{
+    QImage medium(100, 100, QImage::Format_ARGB32);
+    medium.fill(Qt::gray);
+
+    QByteArray payload(500, 'x');
+    QBuffer source(&payload);
+    source.open(QIODevice::ReadOnly);
+
+    // Claim more data than the source actually has
+    PxCrypt::StandardEncoder enc;
+    QImage encoded;
+    PxCrypt::StandardEncoder::Error eErr = enc.encode(encoded, source, payload.size() + 100, medium);
+    QCOMPARE(eErr.type(), PxCrypt::StandardEncoder::Error::WeaveFailed);
+    QVERIFY(encoded.isNull());
+}
+
+void tst_encode_decode::in_place_padded_buffer()
+{
+    // Caller owned pixels with padding at the end of each line
+    const int width = 37, height = 29, padding = 16;
+    const qsizetype bytesPerLine = width * 4 + padding;
+    QByteArray pixels(bytesPerLine * height, Qt::Uninitialized);
+    for(qsizetype i = 0; i < pixels.size(); ++i)
+        pixels[i] = char(i * 31 + 7);
+    const QByteArray original = pixels;
+
+    QImage image(reinterpret_cast<uchar*>(pixels.data()), width, height, bytesPerLine, QImage::Format_ARGB32);
+    const QImage medium = image.copy();
+
+    QByteArray payload("In place, without a second image");
+    PxCrypt::StandardEncoder enc;
+    enc.setBpc(2);
+    enc.setEncoding(PxCrypt::Encoder::Relative);
+    enc.setTag("tag");
+
+    // Encode in place and via a copy, which must agree
+    PxCrypt::StandardEncoder::Error eErr = enc.encodeInPlace(image, payload);
+    QVERIFY2(!eErr, C_STR(eErr.errorString()));
+    QCOMPARE(image.constBits(), reinterpret_cast<const uchar*>(pixels.constData()));
+
+    QImage encoded;
+    eErr = enc.encode(encoded, payload, medium);
+    QVERIFY2(!eErr, C_STR(eErr.errorString()));
+    QCOMPARE(image, encoded);
+
+    // Padding is not touched
+    for(int y = 0; y < height; ++y)
+    {
+        qsizetype pad = y * bytesPerLine + width * 4;
+        QCOMPARE(pixels.mid(pad, padding), original.mid(pad, padding));
+    }
+
+    // Decode
+    PxCrypt::StandardDecoder dec;
+    QByteArray decoded;
+    PxCrypt::StandardDecoder::Error dErr = dec.decode(decoded, image, medium);
+    QVERIFY2(!dErr, C_STR(dErr.errorString()));
+    QCOMPARE(decoded, payload);
+}
+
+void tst_encode_decode::parallel_matches_sequential()
+{
+    // Large enough that the payload is split between threads
+    QRandomGenerator rng(0x5EED);
+    QImage medium(1000, 800, QImage::Format_ARGB32);
+    for(int y = 0; y < medium.height(); ++y)
+    {
+        QRgb* line = reinterpret_cast<QRgb*>(medium.scanLine(y));
+        for(int x = 0; x < medium.width(); ++x)
+            line[x] = rng.generate();
+    }
+
+    QByteArray payload(600 * 1024, Qt::Uninitialized);
+    rng.fillRange(reinterpret_cast<quint32*>(payload.data()), payload.size() / sizeof(quint32));
+
+    for(auto encoding : {PxCrypt::Encoder::Absolute, PxCrypt::Encoder::Relative})
+    {
+        PxCrypt::StandardEncoder enc;
+        enc.setBpc(3);
+        enc.setEncoding(encoding);
+
+        QImage sequential;
+        PxCrypt::StandardEncoder::Error eErr = enc.encode(sequential, payload, medium);
+        QVERIFY2(!eErr, C_STR(eErr.errorString()));
+
+        enc.setThreadCount(4);
+        QImage parallel;
+        eErr = enc.encode(parallel, payload, medium);
+        QVERIFY2(!eErr, C_STR(eErr.errorString()));
+        QCOMPARE(parallel, sequential);
+
+        PxCrypt::StandardDecoder dec;
+        dec.setThreadCount(4);
+        QByteArray decoded;
+        PxCrypt::StandardDecoder::Error dErr = dec.decode(decoded, parallel, medium);
+        QVERIFY2(!dErr, C_STR(dErr.errorString()));
+        QCOMPARE(decoded, payload);
+    }
+}
+
+void tst_encode_decode::memory_order_matches_traversal()
+{
+    // Large enough that the payload spans multiple runs when reading in memory order
+    QRandomGenerator rng(0x0DE5);
+    QImage medium(1200, 1000, QImage::Format_ARGB32);
+    for(int y = 0; y < medium.height(); ++y)
+    {
+        QRgb* line = reinterpret_cast<QRgb*>(medium.scanLine(y));
+        for(int x = 0; x < medium.width(); ++x)
+            line[x] = rng.generate();
+    }
+
+    QByteArray payload(420 * 1024, Qt::Uninitialized);
+    rng.fillRange(reinterpret_cast<quint32*>(payload.data()), payload.size() / sizeof(quint32));
+
+    for(auto encoding : {PxCrypt::Encoder::Absolute, PxCrypt::Encoder::Relative})
+    {
+        for(auto revision : {PxCrypt::Encoder::Original, PxCrypt::Encoder::Permutation, PxCrypt::Encoder::BlockShuffle})
+        {
+            PxCrypt::StandardEncoder enc;
+            enc.setBpc(1);
+            enc.setEncoding(encoding);
+            enc.setRevision(revision);
+
+            QImage encoded;
+            PxCrypt::StandardEncoder::Error eErr = enc.encode(encoded, payload, medium);
+            QVERIFY2(!eErr, C_STR(eErr.errorString()));
+
+            for(int threads : {1, 4})
+            {
+                PxCrypt::StandardDecoder dec;
+                dec.setThreadCount(threads);
+                dec.setReadOrder(PxCrypt::Decoder::MemoryOrder);
+                QByteArray decoded;
+                PxCrypt::StandardDecoder::Error dErr = dec.decode(decoded, encoded, medium);
+                QVERIFY2(!dErr, C_STR(dErr.errorString()));
+                QCOMPARE(decoded, payload);
+            }
+        }
+    }
 }
 
 QTEST_APPLESS_MAIN(tst_encode_decode)
@@ -49,9 +49,10 @@ void tst_metapixel::invalid_meta_data()
     QDir data(":/data");
     QTest::newRow("invalid_bpc") << data.absoluteFilePath("invalid_bpc.png") << PxCrypt::StandardDecoder::Error::InvalidMeta;
     QTest::newRow("invalid_encoding") << data.absoluteFilePath("invalid_encoding.png") << PxCrypt::StandardDecoder::Error::InvalidMeta;
+    QTest::newRow("invalid_revision") << data.absoluteFilePath("invalid_revision.png") << PxCrypt::StandardDecoder::Error::InvalidMeta;
 
     // NOTE: Current invalid encoding test uses value of 7, if that value ends up occupied then this
-    // needs to change
+    // needs to change. The invalid revision test flags the encoding as revised, but leaves the revision at 0
 }
 
 void tst_metapixel::invalid_meta()
@@ -26,6 +26,7 @@ private slots:
 
     void full_data_cycle_data();
     void full_data_cycle();
+    void lazy_sources_cycle();
 };
 
 tst_encode_decode::tst_encode_decode() {}
@@ -122,5 +123,85 @@ void tst_encode_decode::full_data_cycle()
     QCOMPARE(dec.tag(), tag);
 }
 
+void tst_encode_decode::lazy_sources_cycle()
+{
+    // Store mediums on disk
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    auto rng = QRandomGenerator::global();
+    QList<QImage> mediums(6);
+    QList<PxCrypt::ImageSource> sources;
+    for(qsizetype i = 0; i < mediums.size(); ++i)
+    {
+        QImage img(rng->bounded(100, 200), rng->bounded(50, 300), QImage::Format_ARGB32);
+        rng->fillRange(reinterpret_cast<quint32*>(img.bits()), img.sizeInBytes()/4);
+        mediums[i] = img;
+
+        QString path = dir.filePath(QString::number(i) + QStringLiteral(".png"));
+        QVERIFY(img.save(path));
+        sources.append(path);
+    }
+
+    QByteArray payload(9'000, Qt::Uninitialized);
+    rng->fillRange(reinterpret_cast<quint32*>(payload.data()), payload.size()/4);
+
+    PxCrypt::MultiEncoder enc;
+    enc.setPresharedKey(QByteArray("lazy"));
+    enc.setEncoding(PxCrypt::Encoder::Absolute);
+    enc.setTag(QByteArray("Lazy Sources"));
+
+    // Encode from memory
+    QList<QImage> expected;
+    auto eErr = enc.encode(expected, payload, mediums);
+    QVERIFY2(!eErr, C_STR(eErr.errorString()));
+
+    // Encode from disk
+    QMutex mutex;
+    QList<QImage> encoded(mediums.size());
+    eErr = enc.encode(payload, sources, [&](qsizetype index, const QImage& image){
+        QMutexLocker locker(&mutex);
+        encoded[index] = image;
+        return true;
+    });
+    QVERIFY2(!eErr, C_STR(eErr.errorString()));
+    QCOMPARE(encoded, expected);
+
+    // Rejected output
+    eErr = enc.encode(payload, sources, [](qsizetype, const QImage&){ return false; });
+    QCOMPARE(eErr.type(), PxCrypt::MultiEncoder::Error::SinkFailed);
+
+    // Decode
+    PxCrypt::MultiDecoder dec;
+    dec.setPresharedKey(QByteArray("lazy"));
+
+    QByteArray decoded;
+    auto dErr = dec.decode(decoded, encoded);
+    QVERIFY2(!dErr, C_STR(dErr.errorString()));
+    QCOMPARE(decoded, payload);
+
+    // Stream decode from disk, in reverse so that parts arrive out of order
+    QList<PxCrypt::ImageSource> encSources;
+    for(qsizetype i = encoded.size() - 1; i >= 0; --i)
+    {
+        QString path = dir.filePath(QString::number(i) + QStringLiteral("_enc.png"));
+        QVERIFY(encoded[i].save(path));
+        encSources.append(path);
+    }
+
+    QByteArray streamed;
+    QBuffer sink(&streamed);
+    QVERIFY(sink.open(QIODevice::WriteOnly));
+    dErr = dec.decode(sink, encSources);
+    QVERIFY2(!dErr, C_STR(dErr.errorString()));
+    QCOMPARE(streamed, payload);
+    QCOMPARE(dec.tag(), QStringLiteral("Lazy Sources"));
+
+    // Incomplete set
+    sink.reset();
+    dErr = dec.decode(sink, encSources.mid(1));
+    QCOMPARE(dErr.type(), PxCrypt::MultiDecoder::Error::PartsMissing);
+}
+
 QTEST_APPLESS_MAIN(tst_encode_decode)
 #include "tst_multi_encode_decode.moc"
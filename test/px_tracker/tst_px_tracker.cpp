@@ -0,0 +1,92 @@
+// Standard Library Includes
+#include <vector>
+
+// Qt Includes
+#include <QtTest>
+
+// Project Includes
+#include "medium_io/sequence/px_tracker.h"
+
+// Test Includes
+#include <pxcrypt_test_common.h>
+
+using namespace PxCryptPrivate;
+
+namespace
+{
+
+// The straightforward definition of nearest free, scanning outwards with the lower index winning ties
+quint64 naiveNearestFree(const std::vector<bool>& reserved, quint64 index)
+{
+    quint64 total = reserved.size();
+    for(quint64 dist = 0; dist < total; dist++)
+    {
+        if(dist <= index && !reserved[index - dist])
+            return index - dist;
+        if(index + dist < total && !reserved[index + dist])
+            return index + dist;
+    }
+
+    qFatal("No free index");
+    return 0;
+}
+
+}
+
+// Test
+class tst_px_tracker : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_px_tracker();
+
+private slots:
+    // Init
+//    void initTestCase();
+//    void cleanupTestCase();
+
+    // Test cases
+    void reserve_nearest_free_data();
+    void reserve_nearest_free();
+
+};
+
+tst_px_tracker::tst_px_tracker() {}
+//void tst_px_tracker::initTestCase() {}
+//void tst_px_tracker::cleanupTestCase() {}
+
+void tst_px_tracker::reserve_nearest_free_data()
+{
+    // Sizes around word (64) and level (64^2, 64^3) boundaries
+    QTest::addColumn<quint64>("total");
+
+    // Add test rows
+    for(quint64 total : {1, 63, 64, 65, 4097, 262145})
+        QTest::addRow("%llu", total) << total;
+}
+
+void tst_px_tracker::reserve_nearest_free()
+{
+    // Fetch data from test table
+    QFETCH(quint64, total);
+
+    // Book every index, each time from a random position, checking against the reference along the way
+    PxTracker tracker(total);
+    std::vector<bool> reserved(total, false);
+    QRandomGenerator rng(quint32(total));
+    for(quint64 i = 0; i < total; i++)
+    {
+        quint64 index = rng.bounded(total);
+        quint64 expected = naiveNearestFree(reserved, index);
+
+        QCOMPARE(tracker.isFree(index), !reserved[index]);
+        QCOMPARE(tracker.nearestFree(index), expected);
+        QCOMPARE(tracker.reserveNearestFree(index), expected);
+        QVERIFY(!tracker.isFree(expected));
+        reserved[expected] = true;
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_px_tracker)
+#include "tst_px_tracker.moc"
@@ -3,7 +3,7 @@
 
 // Qt Includes
 #include <QImageReader>
-#include <QImageWriter>
+#include <QTemporaryFile>
 
 // Qx Includes
 #include <qx/io/qx-common-io.h>
@@ -60,24 +60,7 @@ CDecode::CDecode(Core& coreRef) : Command(coreRef)
 
 //-Instance Functions-------------------------------------------------------------
 //Private:
-CDecodeError CDecode::loadMultiImages(QList<QImage>& images, const QStringList& paths, const CDecodeError& baseError)
-{
-    images.resize(paths.size());
-
-    QImageReader imgReader;
-    for(qsizetype i = 0; i < paths.size(); ++i)
-    {
-        auto& ip = paths.at(i);
-        QImage& im = images[i];
-        imgReader.setFileName(ip);
-        if(!imgReader.read(&im))
-            return baseError.wSpecific(imgReader.errorString(), ip);
-    }
-
-    return {};
-}
-
-Qx::Error CDecode::decodeSingleImage(QByteArray& decoded, QString& tag, const QString& encodedPath, const std::optional<QString>& mediumPath, QByteArrayView psk)
+Qx::Error CDecode::decodeSingleImage(QIODevice& decoded, QString& tag, const QString& encodedPath, const std::optional<QString>& mediumPath, QByteArrayView psk)
 {
     QImageReader imgReader;
 
@@ -109,7 +92,7 @@ Qx::Error CDecode::decodeSingleImage(QByteArray& decoded, QString& tag, const QS
     return {};
 }
 
-Qx::Error CDecode::decodeMultipleImages(QByteArray& decoded, QString& tag,  const QDir& encodedDir, const std::optional<QDir>& mediumDir, QByteArrayView psk)
+Qx::Error CDecode::decodeMultipleImages(QIODevice& decoded, QString& tag,  const QDir& encodedDir, const std::optional<QDir>& mediumDir, QByteArrayView psk)
 {
     // TODO: Don't even try to load lossy image formats
 
@@ -134,18 +117,12 @@ Qx::Error CDecode::decodeMultipleImages(QByteArray& decoded, QString& tag,  cons
 
     mCore.printMessage(NAME, MSG_MULTI_DECODE_COUNT.arg(encodedPaths.count()));
 
-    // Load encoded images
-    QList<QImage> encoded;
-    if(auto err = loadMultiImages(encoded, encodedPaths, ERR_INPUT_READ_FAILED))
-        return err;
-
-    // Load mediums, if applicable
-    QList<QImage> mediums;
-    if(!mediumPaths.isEmpty())
-    {
-        if(auto err = loadMultiImages(mediums, mediumPaths, ERR_MEDIUM_READ_FAILED))
-            return err;
-    }
+    /* Images are handed to the decoder by path, so that each worker loads its encoded/medium pair concurrently with
+     * the others and decodes it as soon as it has, and each part is written out as soon as the ones before it have
+     * been. This way neither the image set nor the payload ever has to be fully in memory.
+     */
+    QList<PxCrypt::ImageSource> encoded(encodedPaths.cbegin(), encodedPaths.cend());
+    QList<PxCrypt::ImageSource> mediums(mediumPaths.cbegin(), mediumPaths.cend());
 
     // Decode
     PxCrypt::MultiDecoder decoder;
@@ -153,7 +130,14 @@ Qx::Error CDecode::decodeMultipleImages(QByteArray& decoded, QString& tag,  cons
 
     mCore.printMessage(NAME, MSG_DECODING);
     if(auto err = decoder.decode(decoded, encoded, mediums))
+    {
+        qsizetype idx = err.imageIndex();
+        if(err.type() == PxCrypt::MultiDecoder::Error::InvalidSource && idx >= 0)
+            return ERR_INPUT_READ_FAILED.wSpecific(err.specific(), encodedPaths.value(idx));
+        else if(err.type() == PxCrypt::MultiDecoder::Error::MissingMediums && idx >= 0 && !err.specific().isEmpty())
+            return ERR_MEDIUM_READ_FAILED.wSpecific(err.specific(), mediumPaths.value(idx));
         return err;
+    }
 
     tag = decoder.tag();
     return {};
@@ -203,8 +187,27 @@ Qx::Error CDecode::perform()
     }
 
     //-Decoding---------------------------------------
+
+    /* The payload is streamed straight to a temporary file in the output directory, which is only given its
+     * final name, the tag, once decoding has succeeded, since the tag isn't known until then.
+     */
+    QDir outputDir(mParser.isSet(CL_OPTION_OUTPUT) ? mParser.value(CL_OPTION_OUTPUT) : encodedInfo.absoluteDir());
+    if(!outputDir.mkpath(u"."_s))
+    {
+        CDecodeError err = ERR_OUTPUT_WRITE_FAILED.wSpecific(u"Failed to create output path."_s);
+        mCore.printError(NAME, err);
+        return err;
+    }
+
+    QTemporaryFile decoded(outputDir.absoluteFilePath(u"decoding-XXXXXX.part"_s));
+    if(!decoded.open())
+    {
+        CDecodeError err = ERR_OUTPUT_WRITE_FAILED.wSpecific(decoded.errorString());
+        mCore.printError(NAME, err);
+        return err;
+    }
+
     // TODO: Simplify argument passing
-    QByteArray decoded;
     QString tag;
     Qx::Error jobError;
     if(encodedInfo.isDir())
@@ -227,17 +230,23 @@ Qx::Error CDecode::perform()
     mCore.printMessage(NAME, MSG_PAYLOAD_SIZE.arg(Utility::dataStr(decoded.size())));
     mCore.printMessage(NAME, MSG_TAG.arg(tag));
 
-    // Write decoded data
-    QDir outputDir(mParser.isSet(CL_OPTION_OUTPUT) ? mParser.value(CL_OPTION_OUTPUT) : encodedInfo.absoluteDir());
-    QFile outputFile(outputDir.absoluteFilePath(tag));
+    // Give the decoded data its final name
+    QString outputPath = outputDir.absoluteFilePath(tag);
+    if(QFile::exists(outputPath))
+    {
+        CDecodeError err = ERR_OUTPUT_WRITE_FAILED.wSpecific(u"The file already exists."_s, outputPath);
+        mCore.printError(NAME, err);
+        return err;
+    }
 
-    Qx::IoOpReport wr = Qx::writeBytesToFile(outputFile, decoded, Qx::WriteMode::Truncate, 0, Qx::WriteOption::NewOnly | Qx::WriteOption::CreatePath);
-    if(wr.isFailure())
+    if(!decoded.flush() || !decoded.rename(outputPath))
     {
-        mCore.printError(NAME, wr);
-        return wr;
+        CDecodeError err = ERR_OUTPUT_WRITE_FAILED.wSpecific(decoded.errorString(), outputPath);
+        mCore.printError(NAME, err);
+        return err;
     }
-    mCore.printMessage(NAME, MSG_DATA_SAVED.arg(outputFile.fileName()));
+    decoded.setAutoRemove(false);
+    mCore.printMessage(NAME, MSG_DATA_SAVED.arg(outputPath));
 
     return CDecodeError();
 }
@@ -24,7 +24,8 @@ public:
         MediumTypeMismatch,
         MediumCountMismatch,
         FailedReadingMedium,
-        FailedReadingInput
+        FailedReadingInput,
+        FailedWritingOutput
     };
 
 //-Instance Variables------------------------------------------------------------------------------------------------
@@ -73,6 +74,8 @@ private:
         CDecodeError(CDecodeError::FailedReadingMedium, u"Failed reading the medium image(s)."_s);
     static inline const CDecodeError ERR_INPUT_READ_FAILED =
         CDecodeError(CDecodeError::FailedReadingInput, u"Failed reading the input encoded image(s)."_s);
+    static inline const CDecodeError ERR_OUTPUT_WRITE_FAILED =
+        CDecodeError(CDecodeError::FailedWritingOutput, u"Failed writing the decoded data."_s);
 
     // Messages - All
     static inline const QString MSG_DECODING = u"Decoding..."_s;
@@ -122,9 +125,8 @@ public:
 
 //-Instance Functions------------------------------------------------------------------------------------------------------
 private:
-    CDecodeError loadMultiImages(QList<QImage>& images, const QStringList& paths, const CDecodeError& baseError);
-    Qx::Error decodeSingleImage(QByteArray& decoded, QString& tag, const QString& encodedPath, const std::optional<QString>& mediumPath, QByteArrayView psk);
-    Qx::Error decodeMultipleImages(QByteArray& decoded, QString& tag, const QDir& encodedDir, const std::optional<QDir>& mediumDir, QByteArrayView psk);
+    Qx::Error decodeSingleImage(QIODevice& decoded, QString& tag, const QString& encodedPath, const std::optional<QString>& mediumPath, QByteArrayView psk);
+    Qx::Error decodeMultipleImages(QIODevice& decoded, QString& tag, const QDir& encodedDir, const std::optional<QDir>& mediumDir, QByteArrayView psk);
 
 protected:
     const QList<const QCommandLineOption*> options() override;
@@ -4,6 +4,7 @@
 // Qt Includes
 #include <QImageReader>
 #include <QImageWriter>
+#include <QMutex>
 
 // Qx Includes
 #include <qx/io/qx-common-io.h>
@@ -11,6 +12,7 @@
 // Project Includes
 #include "pxcrypt/codec/standard_encoder.h"
 #include "pxcrypt/codec/multi_encoder.h"
+#include "kernel/stage.h"
 #include "utility.h"
 
 //===============================================================================================================
@@ -77,6 +79,7 @@ Qx::Error CEncode::encodeSingleImage(const Job& job)
     encoder.setBpc(job.bpc);
     encoder.setPresharedKey(job.psk.toByteArray());
     encoder.setEncoding(job.encoding);
+    encoder.setRevision(job.revision);
     encoder.setTag(job.tag.toUtf8());
 
     mCore.printMessage(NAME, MSG_START_ENCODING);
@@ -103,6 +106,7 @@ Qx::Error CEncode::encodeSingleImage(const Job& job)
         return ERR_OUTPUT_WRITE_FAILED.wSpecific(u"The file already exists."_s);
 
     QImageWriter imgWriter(outputPath);
+    imgWriter.setCompression(job.pngLevel);
     if(!imgWriter.write(encoded))
         return ERR_OUTPUT_WRITE_FAILED.wSpecific(imgWriter.errorString());
 
@@ -122,67 +126,89 @@ Qx::Error CEncode::encodeMultipleImages(const Job& job)
 
     mCore.printMessage(NAME, MSG_MULTI_IMAGE_COUNT.arg(mediumPaths.count()));
 
-    /* Load all mediums
-     *
-     * TODO: We could reduce memory usage here by introducing an image wraper type (i.e. InputImage) or something
-     * that the lib takes. It would have a ctor for a QFile or QString as a file path, and one for QImage. The
-     * latter ctor would allow the library to work as is, where images are pre-loaded, but the former would allow
-     * the image to be loaded on demand by the encoder from disk, so there would only be as many images in memory
-     * at once as there are threads.
-     *
-     * In theory this could also be done for the payload, so that the segments given to the workers are only
-     * loaded as the worker is live, though this would be a little more involved.
+    // Setup root output exists
+    QDir outputDir(mParser.isSet(CL_OPTION_OUTPUT) ?
+        mParser.value(CL_OPTION_OUTPUT) :
+        mediumDir.absolutePath() + "_enc"
+    );
+    if(!outputDir.mkpath(u"."_s))
+        return ERR_OUTPUT_WRITE_FAILED.wSpecific(u"Failed to create root path."_s);
+
+    /* The job runs as a pipeline. Mediums are handed to the encoder by path so that each weaving worker loads
+     * its image only right before encoding it, and every encoded image is passed on to a separate set of
+     * writers as soon as it's ready, since PNG compression is usually slower than weaving. Weaving stalls
+     * whenever the writers fall behind by more than one image each, so only about as many images as there are
+     * workers in both stages are ever in memory at once, and the total time tends towards that of the slowest
+     * stage instead of the sum of all of them.
      */
-    QImageReader imgReader;
-    QList<QImage> mediums(mediumPaths.size());
-    for(qsizetype i = 0; i < mediums.size(); ++i)
-    {
-        auto& mp = mediumPaths.at(i);
-        QImage& m = mediums[i];
-        imgReader.setFileName(mp);
-        if(!imgReader.read(&m))
-            return ERR_MEDIUM_READ_FAILED.wSpecific(imgReader.errorString(), mp);
-    }
+    QList<PxCrypt::ImageSource> mediums;
+    mediums.reserve(mediumPaths.size());
+    for(const QString& mp : std::as_const(mediumPaths))
+        mediums.append(mp);
+
+    QMutex writeErrorMutex;
+    CEncodeError writeError;
+    auto failWrite = [&](const CEncodeError& err){
+        QMutexLocker locker(&writeErrorMutex);
+        if(!writeError)
+            writeError = err;
+    };
+
+    int weavers = job.weavers > 0 ? job.weavers : QThread::idealThreadCount();
+    Stage writeStage(job.writers);
+    mCore.printMessage(NAME, MSG_MULTI_WORKERS.arg(weavers).arg(writeStage.workers()));
+
+    auto writeEncoded = [&](qsizetype i, const QImage& enc){
+        {
+            QMutexLocker locker(&writeErrorMutex);
+            if(writeError)
+                return false;
+        }
+
+        writeStage.submit([&, i, enc]{
+            auto& mp = mediumPaths.at(i);
+            const QFileInfo rmpInfo(mediumDir.relativeFilePath(mp));
+            const QString rep = rmpInfo.path() + '/' + rmpInfo.baseName() + '.' + OUTPUT_EXT;
+            const QString encodedPath = outputDir.absoluteFilePath(rep);
+
+            if(!outputDir.mkpath(rmpInfo.path()))
+            {
+                failWrite(ERR_OUTPUT_WRITE_FAILED.wSpecific(u"Failed to create sub-directory."_s, encodedPath));
+                return;
+            }
+
+            QImageWriter imgWriter(encodedPath);
+            imgWriter.setCompression(job.pngLevel);
+            if(!imgWriter.write(enc))
+                failWrite(ERR_OUTPUT_WRITE_FAILED.wSpecific(imgWriter.errorString(), encodedPath));
+        });
+
+        return true;
+    };
 
     // Encode
     PxCrypt::MultiEncoder encoder;
     encoder.setBpc(job.bpc);
     encoder.setPresharedKey(job.psk.toByteArray());
     encoder.setEncoding(job.encoding);
+    encoder.setRevision(job.revision);
     encoder.setTag(job.tag.toUtf8());
+    encoder.setImageConcurrency(weavers);
 
     mCore.printMessage(NAME, MSG_START_ENCODING);
-    QList<QImage> encoded;
-    if(auto err = encoder.encode(encoded, job.payload, mediums))
+    auto err = encoder.encode(job.payload, mediums, writeEncoded);
+    writeStage.waitForDone();
+    if(writeError)
+        return writeError;
+    else if(err.type() == PxCrypt::MultiEncoder::Error::InvalidImage)
+        return ERR_MEDIUM_READ_FAILED.wSpecific(err.specific(), mediumPaths.value(err.imageIndex()));
+    else if(err)
         return err;
 
     // Print approximate density if auto was used
     if(job.bpc == 0)
         mCore.printMessage(NAME, MSG_MULTI_APROX_BPC.arg(encoder.bpc()));
 
-    // Setup root output exists
-    QDir outputDir(mParser.isSet(CL_OPTION_OUTPUT) ?
-        mParser.value(CL_OPTION_OUTPUT) :
-        mediumDir.absolutePath() + "_enc"
-    );
-    if(!outputDir.mkpath(u"."_s))
-        return ERR_OUTPUT_WRITE_FAILED.wSpecific(u"Failed to create root path."_s);
-
-    // Write encoded images
-    QImageWriter imgWriter;
-    for(qsizetype i = 0; i < encoded.size(); ++i)
-    {
-        auto& mp = mediumPaths.at(i);
-        const QFileInfo rmpInfo(mediumDir.relativeFilePath(mp));
-        const QString rep = rmpInfo.path() + '/' + rmpInfo.baseName() + '.' + OUTPUT_EXT;
-        const QString encodedPath = outputDir.absoluteFilePath(rep);
-
-        auto& enc = encoded.at(i);
-        imgWriter.setFileName(encodedPath);
-        if(!imgWriter.write(enc))
-            return ERR_OUTPUT_WRITE_FAILED.wSpecific(imgWriter.errorString(), encodedPath);
-    }
-
     mCore.printMessage(NAME, MSG_MULTI_IMAGE_SAVED.arg(outputDir.absolutePath()));
     return {};
 }
@@ -212,6 +238,21 @@ Qx::Error CEncode::perform()
     }
     mCore.printMessage(NAME, MSG_ENCODING.arg(ENUM_NAME(aEncoding)));
 
+    // Evaluate format revision
+    PxCrypt::Encoder::Revision aRevision;
+    QString revisionStr = mParser.value(CL_OPTION_REVISION);
+
+    auto potentialRevision = magic_enum::enum_cast<PxCrypt::Encoder::Revision>(revisionStr.toStdString());
+    if(potentialRevision.has_value())
+        aRevision = potentialRevision.value();
+    else
+    {
+        CEncodeError err = ERR_INVALID_REVISION.wSpecific(revisionStr);
+        mCore.printError(NAME, err);
+        return err;
+    }
+    mCore.printMessage(NAME, MSG_REVISION.arg(ENUM_NAME(aRevision)));
+
     // Evaluate BPC
     quint8 aBpc;
     QString bpcStr = mParser.value(CL_OPTION_DENSITY);
@@ -235,6 +276,49 @@ Qx::Error CEncode::perform()
     // Get key
     QByteArray aKey = mParser.value(CL_OPTION_KEY).toUtf8();
 
+    // Evaluate PNG compression
+    int aPngLevel;
+    if(mParser.isSet(CL_OPTION_PNG_LEVEL))
+    {
+        bool valid;
+        QString levelStr = mParser.value(CL_OPTION_PNG_LEVEL);
+        aPngLevel = levelStr.toInt(&valid);
+        if(!valid || aPngLevel < 0 || aPngLevel > 9)
+        {
+            CEncodeError err = ERR_INVALID_COMPRESSION.wSpecific(levelStr);
+            mCore.printError(NAME, err);
+            return err;
+        }
+    }
+    else
+    {
+        QString profileStr = mParser.value(CL_OPTION_PNG_PROFILE).toLower();
+        if(!PNG_PROFILES.contains(profileStr))
+        {
+            CEncodeError err = ERR_INVALID_COMPRESSION.wSpecific(profileStr);
+            mCore.printError(NAME, err);
+            return err;
+        }
+        aPngLevel = PNG_PROFILES.value(profileStr);
+    }
+    mCore.printMessage(NAME, MSG_PNG_LEVEL.arg(aPngLevel < 0 ? u"default"_s : QString::number(aPngLevel)));
+
+    // Evaluate worker counts
+    int aWorkers[2];
+    const QCommandLineOption* workerOptions[2] = {&CL_OPTION_WEAVERS, &CL_OPTION_WRITERS};
+    for(int i = 0; i < 2; ++i)
+    {
+        bool valid;
+        QString countStr = mParser.value(*workerOptions[i]);
+        aWorkers[i] = countStr.toInt(&valid);
+        if(!valid || aWorkers[i] < 0)
+        {
+            CEncodeError err = ERR_INVALID_WORKER_COUNT.wSpecific(countStr);
+            mCore.printError(NAME, err);
+            return err;
+        }
+    }
+
     // Get input data info
     QFile inputFile(mParser.value(CL_OPTION_INPUT));
     QFileInfo inputFileInfo(inputFile);
@@ -265,9 +349,13 @@ Qx::Error CEncode::perform()
         .mediumInfo = mediumInfo,
         .bpc = aBpc,
         .encoding = aEncoding,
+        .revision = aRevision,
         .payload = aPayload,
         .psk = aKey,
-        .tag = aTag
+        .tag = aTag,
+        .weavers = aWorkers[0],
+        .writers = aWorkers[1],
+        .pngLevel = aPngLevel
     };
 
     // Do job
@@ -6,6 +6,7 @@
 
 // Qt Includes
 #include <QFileInfo>
+#include <QMap>
 
 // Project Includes
 #include "command.h"
@@ -22,7 +23,10 @@ public:
     {
         NoError,
         InvalidEncoding,
+        InvalidRevision,
         InvalidDensity,
+        InvalidWorkerCount,
+        InvalidCompression,
         MediumDoesNotExist,
         FailedReadingMedium,
         FailedWritingEncoded
@@ -67,9 +71,13 @@ private:
         QFileInfo mediumInfo;
         quint8 bpc;
         PxCrypt::Encoder::Encoding encoding;
+        PxCrypt::Encoder::Revision revision;
         QByteArrayView payload;
         QByteArrayView psk;
         QString tag;
+        int weavers;
+        int writers;
+        int pngLevel;
     };
 
 //-Class Variables------------------------------------------------------------------------------------------------------
@@ -77,8 +85,14 @@ private:
     // Error
     static inline const CEncodeError ERR_INVALID_ENCODING =
         CEncodeError(CEncodeError::InvalidEncoding, u"Invalid encoding:"_s);
+    static inline const CEncodeError ERR_INVALID_REVISION =
+        CEncodeError(CEncodeError::InvalidRevision, u"Invalid format revision:"_s);
     static inline const CEncodeError ERR_INVALID_DENSITY =
         CEncodeError(CEncodeError::InvalidDensity, u"Invalid data density:"_s);
+    static inline const CEncodeError ERR_INVALID_WORKER_COUNT =
+        CEncodeError(CEncodeError::InvalidWorkerCount, u"Invalid worker count:"_s);
+    static inline const CEncodeError ERR_INVALID_COMPRESSION =
+        CEncodeError(CEncodeError::InvalidCompression, u"Invalid PNG compression setting:"_s);
     static inline const CEncodeError ERR_MEDIUM_DOES_NOT_EXIST =
         CEncodeError(CEncodeError::MediumDoesNotExist, u"The provided medium path does not exist."_s);
     static inline const CEncodeError ERR_MEDIUM_READ_FAILED =
@@ -89,10 +103,23 @@ private:
     // Encoding
     static inline const QString OUTPUT_EXT = u"png"_s;
 
+    /* zlib levels for each PNG profile, -1 leaving it to Qt (i.e. zlib's default of 6). Qt's PNG writer doesn't
+     * expose libpng's row filter selection, so the level is the only knob. Compression dominates encode time for
+     * large images, while the noise in the low bits of an encoded image limits what higher levels can gain.
+     */
+    static inline const QMap<QString, int> PNG_PROFILES{
+        {u"store"_s, 0},
+        {u"fast"_s, 1},
+        {u"default"_s, -1},
+        {u"small"_s, 9}
+    };
+
     // Messages - All
     static inline const QString MSG_BPC = u"Bits per channel: %1"_s;
     static inline const QString MSG_PAYLOAD_SIZE = u"Payload size: %1"_s;
     static inline const QString MSG_ENCODING = u"Encoding: %1"_s;
+    static inline const QString MSG_REVISION = u"Format revision: %1"_s;
+    static inline const QString MSG_PNG_LEVEL = u"PNG compression level: %1"_s;
     static inline const QString MSG_START_ENCODING = u"Encoding..."_s;
 
     // Messages - Single
@@ -102,6 +129,7 @@ private:
 
     // Messages - Multi
     static inline const QString MSG_MULTI_IMAGE_COUNT = u"Using %1 images"_s;
+    static inline const QString MSG_MULTI_WORKERS = u"Weaving %1 and writing %2 images at once"_s;
     static inline const QString MSG_MULTI_APROX_BPC = u"Final greatest bits per channel: %1"_s;
     static inline const QString MSG_MULTI_IMAGE_SAVED = u"Wrote encoded images to '%1'"_s;
 
@@ -129,6 +157,24 @@ private:
     static inline const QString CL_OPT_KEY_DESC = u"An optional key to require in order to decode the encoded image."_s;
     static inline const QString CL_OPT_KEY_DEFAULT = u""_s;
 
+    static inline const QString CL_OPT_PNG_PROFILE_L_NAME = u"png-profile"_s;
+    static inline const QString CL_OPT_PNG_PROFILE_DESC = u"Trade-off between output size and write time for the encoded PNG(s) (store | fast | default | small). "
+                                                          "Defaults to 'default'"_s;
+    static inline const QString CL_OPT_PNG_PROFILE_DEFAULT = u"default"_s;
+
+    static inline const QString CL_OPT_PNG_LEVEL_L_NAME = u"png-level"_s;
+    static inline const QString CL_OPT_PNG_LEVEL_DESC = u"Explicit zlib compression level for the encoded PNG(s) (0-9), overrides the profile."_s;
+
+    static inline const QString CL_OPT_WEAVERS_L_NAME = u"weavers"_s;
+    static inline const QString CL_OPT_WEAVERS_DESC = u"How many images to load and encode at once during a multi-part encode. "
+                                                      "Defaults to the number of logical cores (0)."_s;
+    static inline const QString CL_OPT_WEAVERS_DEFAULT = u"0"_s;
+
+    static inline const QString CL_OPT_WRITERS_L_NAME = u"writers"_s;
+    static inline const QString CL_OPT_WRITERS_DESC = u"How many encoded images to compress and write at once during a multi-part encode. "
+                                                      "Defaults to the number of logical cores (0)."_s;
+    static inline const QString CL_OPT_WRITERS_DEFAULT = u"0"_s;
+
     static inline const QString CL_OPT_ENCODING_S_NAME = u"e"_s;
     static inline const QString CL_OPT_ENCODING_L_NAME = u"encoding"_s;
     static inline const QString CL_OPT_ENCODING_DESC =
@@ -148,6 +194,28 @@ private:
         "Missing description for an encoding type"
     );
 
+    static inline const QString CL_OPT_REVISION_L_NAME = u"revision"_s;
+    static inline const QString CL_OPT_REVISION_DESC =
+        u"The image format revision to use (defaults to Original):\n"
+        "\n"
+        "Original - Readable by every version of PxCrypt\n"
+        "ChannelTable - Faster to encode and decode, but requires a version that supports it to decode\n"
+        "FastRng - Faster still to encode and decode, but requires a version that supports it to decode\n"
+        "Permutation - Like FastRng, but uses no extra memory and is fastest for very large images\n"
+        "BlockShuffle - Like Permutation, but visits pixels in small contiguous blocks, which is faster still\n"_s;
+    static inline const QString CL_OPT_REVISION_DEFAULT = u"Original"_s;
+
+    // NOTE: Same as above, for PxCrypt::Encoder::Revision
+    static_assert(magic_enum::enum_values<PxCrypt::Encoder::Revision>() == std::array<PxCrypt::Encoder::Revision, 5>{
+            PxCrypt::Encoder::Revision::Original,
+            PxCrypt::Encoder::Revision::ChannelTable,
+            PxCrypt::Encoder::Revision::FastRng,
+            PxCrypt::Encoder::Revision::Permutation,
+            PxCrypt::Encoder::Revision::BlockShuffle
+        },
+        "Missing description for a format revision"
+    );
+
     // Command line options
     static inline const QCommandLineOption CL_OPTION_INPUT{{CL_OPT_INPUT_S_NAME, CL_OPT_INPUT_L_NAME}, CL_OPT_INPUT_DESC, "input"}; // Takes value
     static inline const QCommandLineOption CL_OPTION_OUTPUT{{CL_OPT_OUTPUT_S_NAME, CL_OPT_OUTPUT_L_NAME}, CL_OPT_OUTPUT_DESC, "output"}; // Takes value
@@ -155,9 +223,16 @@ private:
     static inline const QCommandLineOption CL_OPTION_DENSITY{{CL_OPT_DENSITY_S_NAME, CL_OPT_DENSITY_L_NAME}, CL_OPT_DENSITY_DESC, "density", CL_OPT_DENSITY_DEFAULT}; // Takes value
     static inline const QCommandLineOption CL_OPTION_KEY{{CL_OPT_KEY_S_NAME, CL_OPT_KEY_L_NAME}, CL_OPT_KEY_DESC, "key", CL_OPT_KEY_DEFAULT}; // Takes value
     static inline const QCommandLineOption CL_OPTION_TYPE{{CL_OPT_ENCODING_S_NAME, CL_OPT_ENCODING_L_NAME}, CL_OPT_ENCODING_DESC, "encoding", CL_OPT_ENCODING_DEFAULT}; // Takes value
+    static inline const QCommandLineOption CL_OPTION_REVISION{{CL_OPT_REVISION_L_NAME}, CL_OPT_REVISION_DESC, "revision", CL_OPT_REVISION_DEFAULT}; // Takes value
+    static inline const QCommandLineOption CL_OPTION_PNG_PROFILE{{CL_OPT_PNG_PROFILE_L_NAME}, CL_OPT_PNG_PROFILE_DESC, "profile", CL_OPT_PNG_PROFILE_DEFAULT}; // Takes value
+    static inline const QCommandLineOption CL_OPTION_PNG_LEVEL{{CL_OPT_PNG_LEVEL_L_NAME}, CL_OPT_PNG_LEVEL_DESC, "level"}; // Takes value
+    static inline const QCommandLineOption CL_OPTION_WEAVERS{{CL_OPT_WEAVERS_L_NAME}, CL_OPT_WEAVERS_DESC, "weavers", CL_OPT_WEAVERS_DEFAULT}; // Takes value
+    static inline const QCommandLineOption CL_OPTION_WRITERS{{CL_OPT_WRITERS_L_NAME}, CL_OPT_WRITERS_DESC, "writers", CL_OPT_WRITERS_DEFAULT}; // Takes value
 
     static inline const QList<const QCommandLineOption*> CL_OPTIONS_SPECIFIC{&CL_OPTION_INPUT, &CL_OPTION_OUTPUT, &CL_OPTION_MEDIUM,
-                                                                             &CL_OPTION_DENSITY, &CL_OPTION_KEY, &CL_OPTION_TYPE};
+                                                                             &CL_OPTION_DENSITY, &CL_OPTION_KEY, &CL_OPTION_TYPE,
+                                                                             &CL_OPTION_REVISION, &CL_OPTION_PNG_PROFILE, &CL_OPTION_PNG_LEVEL, &CL_OPTION_WEAVERS,
+                                                                             &CL_OPTION_WRITERS};
     static inline const QSet<const QCommandLineOption*> CL_OPTIONS_REQUIRED{&CL_OPTION_INPUT, &CL_OPTION_MEDIUM};
 
 public:
@@ -0,0 +1,34 @@
+// Unit Includes
+#include "stage.h"
+
+//===============================================================================================================
+// Stage
+//===============================================================================================================
+
+//-Constructor-------------------------------------------------------------
+//Public:
+Stage::Stage(int workers, int backlog)
+{
+    mPool.setMaxThreadCount(workers > 0 ? workers : QThread::idealThreadCount());
+    mSlots.release(backlog > 0 ? backlog : mPool.maxThreadCount());
+}
+
+//-Destructor-------------------------------------------------------------
+//Public:
+Stage::~Stage() { waitForDone(); }
+
+//-Instance Functions-------------------------------------------------------------
+//Public:
+int Stage::workers() const { return mPool.maxThreadCount(); }
+
+void Stage::submit(std::function<void()> task)
+{
+    // A slot covers a task from when it's queued until it's finished
+    mSlots.acquire();
+    mPool.start([this, task = std::move(task)]{
+        task();
+        mSlots.release();
+    });
+}
+
+void Stage::waitForDone() { mPool.waitForDone(); }
@@ -0,0 +1,39 @@
+#ifndef STAGE_H
+#define STAGE_H
+
+// Standard Library Includes
+#include <functional>
+
+// Qt Includes
+#include <QSemaphore>
+#include <QThreadPool>
+
+/* One stage of a processing pipeline, i.e. a set of workers with their own threads and a bounded backlog.
+ * submit() blocks while the backlog is full, which holds back whichever stage is feeding this one when it's
+ * the slower of the two, so that finished but unprocessed work can't pile up in memory.
+ *
+ * A worker count of 0 means one per logical core, and a backlog of 0 means one task per worker.
+ */
+class Stage
+{
+//-Instance Variables------------------------------------------------------------------------------------------------
+private:
+    QThreadPool mPool;
+    QSemaphore mSlots;
+
+//-Constructor----------------------------------------------------------------------------------------------------------
+public:
+    Stage(int workers, int backlog = 0);
+
+//-Destructor----------------------------------------------------------------------------------------------------------
+public:
+    ~Stage();
+
+//-Instance Functions---------------------------------------------------------------------------------------------------
+public:
+    int workers() const;
+    void submit(std::function<void()> task);
+    void waitForDone();
+};
+
+#endif // STAGE_H